@@ -4,6 +4,7 @@
 
 #include "AlgorithmParameters.h"
 #include <iostream>
+#include <cstring>
 
 extern "C"
 struct AlgorithmParameters default_algorithm_parameters() {
@@ -26,6 +27,18 @@ struct AlgorithmParameters default_algorithm_parameters() {
 	ap.timeLimit = 0;
 	ap.useSwapStar = 1;
 
+	ap.nbThreads = 1;
+	ap.parallelScheme = 0;
+	ap.migrationInterval = 500;
+	ap.migrationTopology = 0;
+	ap.timeLimitConstruction = 0;
+	ap.nbEliteRestart = 4;
+	ap.crossoverType = 0;
+	ap.sweepFraction = 0.25;
+	ap.adaptiveMoveOrder = 0;
+	ap.gap = 0;
+	ap.deterministic = 0;
+
 	return ap;
 }
 
@@ -46,5 +59,53 @@ void print_algorithm_parameters(const AlgorithmParameters & ap)
 	std::cout << "---- nbIterTraces            is set to " << ap.nbIterTraces << std::endl;
 	std::cout << "---- timeLimit               is set to " << ap.timeLimit << std::endl;
 	std::cout << "---- useSwapStar             is set to " << ap.useSwapStar << std::endl;
+	std::cout << "---- nbThreads               is set to " << ap.nbThreads << std::endl;
+	std::cout << "---- parallelScheme          is set to " << ap.parallelScheme << std::endl;
+	std::cout << "---- migrationInterval       is set to " << ap.migrationInterval << std::endl;
+	std::cout << "---- migrationTopology       is set to " << ap.migrationTopology << std::endl;
+	std::cout << "---- timeLimitConstruction   is set to " << ap.timeLimitConstruction << std::endl;
+	std::cout << "---- nbEliteRestart          is set to " << ap.nbEliteRestart << std::endl;
+	std::cout << "---- crossoverType           is set to " << ap.crossoverType << std::endl;
+	std::cout << "---- sweepFraction           is set to " << ap.sweepFraction << std::endl;
+	std::cout << "---- adaptiveMoveOrder       is set to " << ap.adaptiveMoveOrder << std::endl;
+	std::cout << "---- gap                     is set to " << ap.gap << std::endl;
+	std::cout << "---- deterministic           is set to " << ap.deterministic << std::endl;
 	std::cout << "==================================================" << std::endl;
 }
+
+const AlgorithmParameterField algorithmParameterFields[] =
+{
+	{ "nbGranular", &AlgorithmParameters::nbGranular, nullptr },
+	{ "mu", &AlgorithmParameters::mu, nullptr },
+	{ "lambda", &AlgorithmParameters::lambda, nullptr },
+	{ "nbElite", &AlgorithmParameters::nbElite, nullptr },
+	{ "nbClose", &AlgorithmParameters::nbClose, nullptr },
+	{ "nbIterPenaltyManagement", &AlgorithmParameters::nbIterPenaltyManagement, nullptr },
+	{ "targetFeasible", nullptr, &AlgorithmParameters::targetFeasible },
+	{ "penaltyDecrease", nullptr, &AlgorithmParameters::penaltyDecrease },
+	{ "penaltyIncrease", nullptr, &AlgorithmParameters::penaltyIncrease },
+	{ "seed", &AlgorithmParameters::seed, nullptr },
+	{ "nbIter", &AlgorithmParameters::nbIter, nullptr },
+	{ "nbIterTraces", &AlgorithmParameters::nbIterTraces, nullptr },
+	{ "timeLimit", nullptr, &AlgorithmParameters::timeLimit },
+	{ "useSwapStar", &AlgorithmParameters::useSwapStar, nullptr },
+	{ "nbThreads", &AlgorithmParameters::nbThreads, nullptr },
+	{ "parallelScheme", &AlgorithmParameters::parallelScheme, nullptr },
+	{ "migrationInterval", &AlgorithmParameters::migrationInterval, nullptr },
+	{ "migrationTopology", &AlgorithmParameters::migrationTopology, nullptr },
+	{ "timeLimitConstruction", nullptr, &AlgorithmParameters::timeLimitConstruction },
+	{ "nbEliteRestart", &AlgorithmParameters::nbEliteRestart, nullptr },
+	{ "crossoverType", &AlgorithmParameters::crossoverType, nullptr },
+	{ "sweepFraction", nullptr, &AlgorithmParameters::sweepFraction },
+	{ "adaptiveMoveOrder", &AlgorithmParameters::adaptiveMoveOrder, nullptr },
+	{ "gap", nullptr, &AlgorithmParameters::gap },
+	{ "deterministic", &AlgorithmParameters::deterministic, nullptr },
+	{ nullptr, nullptr, nullptr }
+};
+
+const AlgorithmParameterField * find_algorithm_parameter(const char * name)
+{
+	for (const AlgorithmParameterField * field = algorithmParameterFields; field->name != nullptr; field++)
+		if (std::strcmp(field->name, name) == 0) return field;
+	return nullptr;
+}
@@ -22,8 +22,20 @@ struct AlgorithmParameters {
 	int seed;				// Random seed. Default value: 0
 	int nbIter;				// Nb iterations without improvement until termination (or restart if a time limit is specified). Default value: 20,000 iterations
 	int nbIterTraces;       // Number of iterations between traces display during HGS execution
-	double timeLimit;		// CPU time limit until termination in seconds. Default value: 0 (i.e., inactive)
+	double timeLimit;		// Time limit until termination in seconds (wall-clock time). Default value: 0 (i.e., inactive)
 	int useSwapStar;		// Use SWAP* local search or not. Default value: 1. Only available when coordinates are provided.
+
+	int nbThreads;			// Number of threads. Default value: 1
+	int parallelScheme;		// Use of the threads: 0 = island model (independent HGS islands), 1 = shared population (offspring generated in parallel). Default value: 0
+	int migrationInterval;	// Island model: number of iterations between two migrations of elite individuals. Default value: 500
+	int migrationTopology;	// Island model: destination of the migrants, 0 = ring (next island), 1 = random island. Default value: 0
+	double timeLimitConstruction;	// Time limit in seconds for building each population (initial population and restarts), within the overall time limit. Default value: 0 (i.e., inactive)
+	int nbEliteRestart;		// Number of elite solutions kept across restarts. The new population is built by ruin and recreate of these solutions (0 = complete regeneration). Default value: 4
+	int crossoverType;		// Crossover operator: 0 = OX on the giant tours (followed by Split), 1 = SREX (selective route exchange, which keeps the routes of the parents). Default value: 0
+	double sweepFraction;	// Fraction of the initial individuals built from a sweep of the clients around the depot instead of a random giant tour. Default value: 0.25. Only available when coordinates are provided.
+	int adaptiveMoveOrder;	// Order of the local search neighborhoods: 0 = fixed order, 1 = adaptive order by observed gain per nanosecond (not reproducible, ignored in the deterministic mode). Default value: 0
+	double gap;				// Early termination once the best solution is within this percentage of a lower bound computed in parallel with the search. Default value: 0 (i.e., inactive)
+	int deterministic;		// Reproducible parallel modes: the same instance, seed and number of threads give the same solution (without time limit), at the cost of some synchronization. Default value: 0
 };
 
 #ifdef __cplusplus
@@ -33,6 +45,20 @@ struct AlgorithmParameters default_algorithm_parameters();
 
 #ifdef __cplusplus
 void print_algorithm_parameters(const AlgorithmParameters & ap);
+
+// Field of AlgorithmParameters with its name, used to set the parameters by name (daemon mode and Python binding)
+struct AlgorithmParameterField
+{
+	const char * name;								// Name of the field
+	int AlgorithmParameters::* intField;			// Integer field (NULL if the field is real)
+	double AlgorithmParameters::* doubleField;		// Real field (NULL if the field is integer)
+};
+
+// All fields of AlgorithmParameters, followed by an entry whose name is NULL
+extern const AlgorithmParameterField algorithmParameterFields[];
+
+// Field with the given name (NULL if there is none)
+const AlgorithmParameterField * find_algorithm_parameter(const char * name);
 #endif
 
 #endif //ALGORITHMPARAMETERS_H
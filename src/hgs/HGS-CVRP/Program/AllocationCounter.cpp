@@ -0,0 +1,56 @@
+#include "AllocationCounter.h"
+
+#ifdef HGS_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic <long long> nbHeapAllocations(0);
+
+void * operator new(std::size_t size)
+{
+	nbHeapAllocations++;
+	void * p = std::malloc(size ? size : 1);
+	if (p == nullptr) throw std::bad_alloc();
+	return p;
+}
+
+void * operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+long long getNbHeapAllocations()
+{
+	return nbHeapAllocations;
+}
+
+#else
+
+long long getNbHeapAllocations()
+{
+	return -1;
+}
+
+#endif
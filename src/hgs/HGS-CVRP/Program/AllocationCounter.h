@@ -0,0 +1,9 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// Number of heap allocations (calls to the global operator new) since the start of the program
+// Only counted when compiled with HGS_COUNT_ALLOCATIONS, which replaces the global operator new, otherwise returns -1
+// Used by the tests to check that the main loop of the genetic algorithm does not allocate memory once the population is built
+long long getNbHeapAllocations();
+
+#endif
@@ -0,0 +1,225 @@
+#include "Batch.h"
+#include "ThreadPool.h"
+#include "Json.h"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+
+const std::vector <double> Batch::targetGaps = { 2., 1., 0.5, 0.1 };
+
+std::vector <Batch::InstanceEntry> Batch::listInstances(const std::string & path)
+{
+	std::vector <InstanceEntry> instances;
+	if (std::filesystem::is_directory(path))
+	{
+		for (const std::filesystem::directory_entry & entry : std::filesystem::directory_iterator(path))
+			if (entry.is_regular_file() && entry.path().extension() == ".vrp") instances.push_back({ entry.path().string(), 0., -1 });
+		std::sort(instances.begin(), instances.end(), [](const InstanceEntry & instance1, const InstanceEntry & instance2) { return instance1.pathInstance < instance2.pathInstance; });
+	}
+	else
+	{
+		std::ifstream manifest(path);
+		if (!manifest.is_open()) throw std::string("Impossible to open the directory or manifest: " + path);
+		std::filesystem::path directory = std::filesystem::path(path).parent_path();
+		std::string line;
+		while (std::getline(manifest, line))
+		{
+			std::istringstream fields(line);
+			std::string pathInstance;
+			if (!(fields >> pathInstance) || pathInstance[0] == '#') continue;
+			InstanceEntry instance = { pathInstance, 0., -1 };
+			if (fields >> instance.bks) fields >> instance.rounding;
+			if (instance.bks < 0. || instance.rounding < -1 || instance.rounding > 1) throw std::string("Invalid BKS or rounding in the manifest line: " + line);
+			std::filesystem::path instancePath = pathInstance;
+			if (instancePath.is_relative()) instance.pathInstance = (directory / instancePath).string();
+			instances.push_back(instance);
+		}
+	}
+	if (instances.empty()) throw std::string("No instance found in " + path);
+	return instances;
+}
+
+int Batch::readNbClients(const std::string & pathInstance)
+{
+	std::ifstream inputFile(pathInstance);
+	if (!inputFile.is_open()) throw std::string("Impossible to open instance file: " + pathInstance);
+	std::string content, content2;
+	int nbNodes = 0;
+	while (inputFile >> content && content != "NODE_COORD_SECTION")
+		if (content == "DIMENSION") inputFile >> content2 >> nbNodes;
+	if (nbNodes <= 1) throw std::string("Number of nodes is undefined in " + pathInstance);
+	return nbNodes - 1;
+}
+
+void Batch::solveRun(const Run & run, Workspace & workspace)
+{
+	if (!workspace.solver) workspace.solver.reset(new Solver(ap, false));
+	if (workspace.pathInstance != run.pathInstance || workspace.isRoundingInteger != run.isRoundingInteger)
+	{
+		// The instance is only read and loaded when it differs from the last run of the worker (the seeds of an instance are often picked by the same worker)
+		workspace.pathInstance.clear();
+		InstanceCVRPLIB cvrp(run.pathInstance, run.isRoundingInteger);
+		workspace.solver->setInstance(cvrp.nbClients + 1, cvrp.x_coords.data(), cvrp.y_coords.data(), nullptr, 0, false, cvrp.service_time.data(), cvrp.demands.data(),
+			cvrp.vehicleCapacity, cvrp.durationLimit, run.isRoundingInteger, cvrp.isDurationConstraint, nbVehicles);
+		workspace.pathInstance = run.pathInstance;
+		workspace.isRoundingInteger = run.isRoundingInteger;
+	}
+	workspace.solver->setSearchLimits(run.seed, ap.nbIter, ap.timeLimit);
+	const Individual * best = workspace.solver->solve();
+	SolveStatistics statistics = workspace.solver->getStatistics();
+
+	BatchResult result;
+	result.name = run.name;
+	result.nbClients = run.nbClients;
+	result.seed = run.seed;
+	result.bks = run.bks;
+	result.isSolved = (best != NULL);
+	result.cost = (best != NULL) ? best->eval.penalizedCost : 0.;
+	result.nbRoutes = (best != NULL) ? best->eval.nbRoutes : 0;
+	result.time = statistics.time;
+	result.timeBest = statistics.searchProgress.empty() ? statistics.time : statistics.searchProgress.back().time; // Last improvement of the search progress
+	result.nbIterations = statistics.nbIterations;
+	result.nbLocalSearches = statistics.nbLocalSearches;
+	if (run.bks > 0.)
+	{
+		// First solution of the search progress within each target gap (the costs of the search progress are decreasing)
+		for (double targetGap : targetGaps)
+		{
+			double timeToTarget = -1.;
+			for (const SearchState & state : statistics.searchProgress)
+				if (state.cost <= run.bks * (1. + targetGap / 100.) + MY_EPSILON) { timeToTarget = state.time; break; }
+			result.timeToTarget.push_back(timeToTarget);
+		}
+	}
+
+	std::lock_guard <std::mutex> lock(outputMutex);
+	results.push_back(result);
+	if (output.is_open()) output << serializeResult(result, isJson) << std::endl;
+	if (verbose)
+	{
+		std::ostringstream trace;
+		trace << "----- RUN " << results.size() << "/" << runs.size() << " | " << run.name << " | SEED " << run.seed << " | COST ";
+		if (result.isSolved) trace << result.cost;
+		else trace << "NONE";
+		if (result.isSolved && run.bks > 0.) trace << " | GAP " << 100. * (result.cost - run.bks) / run.bks << "%";
+		trace << " | TIME " << result.time << " | TIME TO BEST " << result.timeBest;
+		std::cout << trace.str() << std::endl;
+	}
+}
+
+std::string Batch::serializeResult(const BatchResult & result, bool isJson)
+{
+	// Numbers of the result which are unknown: null in JSON, empty in CSV
+	auto appendNumber = [&](std::string & row, bool isKnown, double value)
+	{
+		if (isKnown) JsonValue::appendNumber(row, value);
+		else if (isJson) row += "null";
+	};
+	bool isGapKnown = (result.isSolved && result.bks > 0.);
+	std::string row;
+	if (isJson)
+	{
+		row = "{\"instance\":";
+		JsonValue::appendString(row, result.name);
+		row += ",\"nbClients\":" + std::to_string(result.nbClients) + ",\"seed\":" + std::to_string(result.seed) + ",\"cost\":";
+		appendNumber(row, result.isSolved, result.cost);
+		row += ",\"nbRoutes\":" + std::to_string(result.nbRoutes) + ",\"time\":";
+		appendNumber(row, true, result.time);
+		row += ",\"timeBest\":";
+		appendNumber(row, true, result.timeBest);
+		row += ",\"nbIterations\":" + std::to_string(result.nbIterations) + ",\"nbLocalSearches\":" + std::to_string(result.nbLocalSearches) + ",\"bks\":";
+		appendNumber(row, result.bks > 0., result.bks);
+		row += ",\"gap\":";
+		appendNumber(row, isGapKnown, 100. * (result.cost - result.bks) / result.bks);
+		row += ",\"timeToTarget\":{";
+		for (size_t k = 0; k < targetGaps.size(); k++)
+		{
+			std::string name;
+			JsonValue::appendNumber(name, targetGaps[k]);
+			row += (k ? ",\"" : "\"") + name + "\":";
+			appendNumber(row, k < result.timeToTarget.size() && result.timeToTarget[k] >= 0., (k < result.timeToTarget.size()) ? result.timeToTarget[k] : 0.);
+		}
+		row += "}}";
+	}
+	else
+	{
+		row = result.name + "," + std::to_string(result.nbClients) + "," + std::to_string(result.seed) + ",";
+		appendNumber(row, result.isSolved, result.cost);
+		row += "," + std::to_string(result.nbRoutes) + ",";
+		appendNumber(row, true, result.time);
+		row += ",";
+		appendNumber(row, true, result.timeBest);
+		row += "," + std::to_string(result.nbIterations) + "," + std::to_string(result.nbLocalSearches) + ",";
+		appendNumber(row, result.bks > 0., result.bks);
+		row += ",";
+		appendNumber(row, isGapKnown, 100. * (result.cost - result.bks) / result.bks);
+		for (size_t k = 0; k < targetGaps.size(); k++)
+		{
+			row += ",";
+			appendNumber(row, k < result.timeToTarget.size() && result.timeToTarget[k] >= 0., (k < result.timeToTarget.size()) ? result.timeToTarget[k] : 0.);
+		}
+	}
+	return row;
+}
+
+void Batch::run(const std::string & pathInstances, const std::string & pathResults, int nbSeeds)
+{
+	if (nbSeeds < 1) throw std::string("The number of seeds should be at least 1");
+
+	// Runs of all instances and seeds, by decreasing number of clients (the seeds of an instance remain consecutive)
+	// An instance whose header cannot be read is reported and skipped
+	runs.clear();
+	for (const InstanceEntry & instance : listInstances(pathInstances))
+	{
+		int nbClients;
+		try { nbClients = readNbClients(instance.pathInstance); }
+		catch (const std::string & e) { std::cout << "EXCEPTION | " << e << std::endl; continue; }
+		std::string name = std::filesystem::path(instance.pathInstance).stem().string();
+		bool isRounding = (instance.rounding == -1) ? isRoundingInteger : (instance.rounding == 1);
+		for (int k = 0; k < nbSeeds; k++) runs.push_back({ instance.pathInstance, name, nbClients, ap.seed + k, instance.bks, isRounding });
+	}
+	std::stable_sort(runs.begin(), runs.end(), [](const Run & run1, const Run & run2) { return run1.nbClients > run2.nbClients; });
+
+	results.clear();
+	if (!pathResults.empty())
+	{
+		std::string extension = std::filesystem::path(pathResults).extension().string();
+		isJson = (extension == ".json" || extension == ".ndjson");
+		output.open(pathResults);
+		if (!output.is_open()) throw std::string("Impossible to open the results file: " + pathResults);
+		if (!isJson)
+		{
+			output << "instance,nbClients,seed,cost,nbRoutes,time,timeBest,nbIterations,nbLocalSearches,bks,gap";
+			for (double targetGap : targetGaps) output << ",timeTo" << targetGap << "%";
+			output << std::endl;
+		}
+	}
+
+	// The runs are picked dynamically by the workers, in the order of the list
+	ThreadPool pool(nbWorkers);
+	std::vector <Workspace> workspaces(pool.size());
+	if (verbose) std::cout << "----- BATCH OF " << runs.size() << " RUNS ON " << pool.size() << " WORKERS" << std::endl;
+	auto startTime = std::chrono::steady_clock::now();
+	pool.parallelFor((int)runs.size(), [&](int i, int thread)
+	{
+		// A run which fails (unreadable or invalid instance) is reported without interrupting the others
+		std::string error;
+		try { solveRun(runs[i], workspaces[thread]); }
+		catch (const std::string & e) { error = e; }
+		catch (const std::exception & e) { error = e.what(); }
+		if (error.empty()) return;
+		workspaces[thread].pathInstance.clear();
+		std::lock_guard <std::mutex> lock(outputMutex);
+		std::cout << "EXCEPTION | " << runs[i].name << " | SEED " << runs[i].seed << " | " << error << std::endl;
+	});
+	if (output.is_open()) output.close();
+	if (verbose) std::cout << "----- BATCH FINISHED IN " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << " SECONDS" << std::endl;
+}
+
+Batch::Batch(const AlgorithmParameters & ap, int nbVehicles, bool isRoundingInteger, bool verbose, int nbWorkers) :
+	ap(ap), nbVehicles(nbVehicles), isRoundingInteger(isRoundingInteger), verbose(verbose), isJson(false)
+{
+	this->nbWorkers = (nbWorkers > 0) ? nbWorkers : std::max<int>(1, (int)std::thread::hardware_concurrency());
+}
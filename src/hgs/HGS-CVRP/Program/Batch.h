@@ -0,0 +1,103 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "Solver.h"
+#include "InstanceCVRPLIB.h"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Results of a run of the batch mode
+struct BatchResult
+{
+	std::string name;								// Name of the instance (file name without extension)
+	int nbClients;									// Number of clients
+	int seed;										// Seed of the search
+	double bks;										// Best known solution value given by the manifest (0 if unknown)
+	bool isSolved;									// Tells if a solution has been found
+	double cost;									// Cost of the best solution
+	int nbRoutes;									// Number of routes of the best solution
+	double time;									// Wall-clock time of the run in seconds
+	double timeBest;								// Time at which the best solution was found
+	long long nbIterations;							// Number of iterations
+	long long nbLocalSearches;						// Number of local searches
+	std::vector <double> timeToTarget;				// Time at which a solution within each of Batch::targetGaps of the BKS was found (-1 if none, empty if the BKS is unknown)
+};
+
+// Batch mode (hgs_batch): solves all instances of a directory or of a manifest with several seeds, in a single process
+// The runs are picked by a pool of worker threads in the order of decreasing instance sizes, such that the longest runs are started first and the last ones fill the remaining cores
+// Each worker keeps its solver (see Solver) and its loaded instance between its runs, and one row of results is written per run as soon as it ends
+class Batch
+{
+private:
+
+	// Run of an instance with one seed
+	struct Run
+	{
+		std::string pathInstance;						// Path of the instance file
+		std::string name;								// Name of the instance (file name without extension)
+		int nbClients;									// Number of clients, read from the header of the instance
+		int seed;										// Seed of the search
+		double bks;										// Best known solution value (0 if unknown)
+		bool isRoundingInteger;							// Rounding of the distances
+	};
+
+	// Instance of a directory or of a manifest
+	struct InstanceEntry
+	{
+		std::string pathInstance;						// Path of the instance file
+		double bks;										// Best known solution value (0 if unknown)
+		int rounding;									// Rounding of the distances given by the manifest (-1 if not given)
+	};
+
+	// Structures kept by a worker thread between its runs
+	struct Workspace
+	{
+		std::unique_ptr <Solver> solver;				// Solver of the worker (NULL before its first run)
+		std::string pathInstance;						// Path of the instance loaded in the solver (empty if none)
+		bool isRoundingInteger;							// Rounding of the distances of this instance
+	};
+
+	AlgorithmParameters ap;								// Parameters of the searches (the seed of the first run of each instance)
+	int nbVehicles;										// Number of vehicles
+	bool isRoundingInteger;								// Rounding of the distances, for the instances whose manifest line does not give it
+	bool verbose;										// Tells if a trace is displayed at the end of each run
+	int nbWorkers;										// Number of runs solved in parallel
+	std::vector <Run> runs;								// Runs of the batch, by decreasing instance size
+	std::vector <BatchResult> results;					// Results of the runs, in their order of completion
+	std::mutex outputMutex;								// Serializes the results and the traces
+	std::ofstream output;								// File of results (not opened if no file is requested)
+	bool isJson;										// Tells if the results are written as NDJSON rather than CSV
+
+	// Instances of a directory (files with the .vrp extension, by name) or of a manifest
+	// Each line of a manifest gives the path of an instance (relative to the manifest), optionally followed by its BKS value and its rounding convention (0 or 1). Lines starting with # are ignored
+	static std::vector <InstanceEntry> listInstances(const std::string & path);
+
+	// Number of clients of an instance, read from its header
+	static int readNbClients(const std::string & pathInstance);
+
+	// Solves a run with the structures of a worker, and records its results
+	void solveRun(const Run & run, Workspace & workspace);
+
+public:
+
+	// Gaps to the BKS (in percent) at which the time to target is measured
+	static const std::vector <double> targetGaps;
+
+	// Serializes the results of a run as a CSV row, or as a JSON object
+	static std::string serializeResult(const BatchResult & result, bool isJson);
+
+	// Solves all instances of a directory or of a manifest with nbSeeds consecutive seeds each
+	// The results are written in a file if pathResults is not empty (NDJSON if its name ends with .json or .ndjson, CSV otherwise)
+	void run(const std::string & pathInstances, const std::string & pathResults, int nbSeeds);
+
+	// Results of the runs of the last batch, in their order of completion
+	const std::vector <BatchResult> & getResults() const { return results; }
+
+	// Constructor: parameters of the searches, and number of worker threads (0 for the number of hardware threads)
+	Batch(const AlgorithmParameters & ap, int nbVehicles, bool isRoundingInteger, bool verbose, int nbWorkers);
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "Benchmark.h"
+#include "Json.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+#include <map>
+
+// Member of a summary of the baseline, throwing a std::string if it is missing
+static const JsonValue & getMember(const JsonValue & summary, const std::string & name)
+{
+	const JsonValue * member = summary.find(name);
+	if (member == nullptr) throw std::string("Missing member in the baseline: " + name);
+	return *member;
+}
+
+void Benchmark::addResult(Summary & summary, const BatchResult & result)
+{
+	summary.nbRuns++;
+	if (result.isSolved) summary.nbSolved++;
+	summary.time += result.time;
+	summary.nbIterations += result.nbIterations;
+	summary.nbLocalSearches += result.nbLocalSearches;
+	if (result.bks <= 0.) return;
+	if (result.isSolved)
+	{
+		double gap = 100. * (result.cost - result.bks) / result.bks;
+		summary.nbGaps++;
+		summary.sumGaps += gap;
+		summary.bestGap = std::min<double>(summary.bestGap, gap);
+	}
+	summary.nbTargetRuns++;
+	summary.timesToTarget.resize(Batch::targetGaps.size());
+	for (size_t k = 0; k < result.timeToTarget.size(); k++)
+	{
+		if (result.timeToTarget[k] < 0.) continue;
+		std::vector <double> & times = summary.timesToTarget[k];
+		times.insert(std::upper_bound(times.begin(), times.end(), result.timeToTarget[k]), result.timeToTarget[k]);
+	}
+}
+
+std::string Benchmark::serializeSummary(const Summary & summary)
+{
+	std::string output = "{\"instance\":";
+	JsonValue::appendString(output, summary.name);
+	output += ",\"nbRuns\":" + std::to_string(summary.nbRuns) + ",\"nbSolved\":" + std::to_string(summary.nbSolved) + ",\"averageGap\":";
+	if (summary.nbGaps > 0) JsonValue::appendNumber(output, summary.sumGaps / summary.nbGaps);
+	else output += "null";
+	output += ",\"bestGap\":";
+	if (summary.nbGaps > 0) JsonValue::appendNumber(output, summary.bestGap);
+	else output += "null";
+	output += ",\"time\":";
+	JsonValue::appendNumber(output, summary.time);
+	output += ",\"nbIterations\":" + std::to_string(summary.nbIterations) + ",\"nbLocalSearches\":" + std::to_string(summary.nbLocalSearches) + ",\"iterationsPerSecond\":";
+	JsonValue::appendNumber(output, (summary.time > 0.) ? summary.nbIterations / summary.time : 0.);
+	output += ",\"localSearchesPerSecond\":";
+	JsonValue::appendNumber(output, (summary.time > 0.) ? summary.nbLocalSearches / summary.time : 0.);
+
+	// Time-to-target curves: the fraction of the runs which reached the target gap by time t is the number of times <= t divided by nbTargetRuns
+	output += ",\"nbTargetRuns\":" + std::to_string(summary.nbTargetRuns) + ",\"timeToTarget\":{";
+	for (size_t k = 0; k < summary.timesToTarget.size(); k++)
+	{
+		std::string name;
+		JsonValue::appendNumber(name, Batch::targetGaps[k]);
+		output += (k ? ",\"" : "\"") + name + "\":[";
+		for (size_t i = 0; i < summary.timesToTarget[k].size(); i++)
+		{
+			if (i) output += ",";
+			JsonValue::appendNumber(output, summary.timesToTarget[k][i]);
+		}
+		output += "]";
+	}
+	output += "}}";
+	return output;
+}
+
+void Benchmark::print() const
+{
+	for (size_t s = 0; s < summaries.size(); s++)
+	{
+		const Summary & summary = summaries[(s + 1) % summaries.size()]; // Instances first, then the summary over all runs
+		std::ostringstream line;
+		line.setf(std::ios::fixed);
+		line.precision(2);
+		line << "----- " << summary.name << " | RUNS " << summary.nbRuns;
+		if (summary.nbGaps > 0) line << " | GAP " << summary.sumGaps / summary.nbGaps << "% (BEST " << summary.bestGap << "%)";
+		for (size_t k = 0; k < summary.timesToTarget.size(); k++)
+		{
+			const std::vector <double> & times = summary.timesToTarget[k];
+			line << " | " << std::defaultfloat << Batch::targetGaps[k] << std::fixed << "%: " << times.size() << "/" << summary.nbTargetRuns;
+			if (!times.empty()) line << " IN " << times[times.size() / 2] << "s"; // Median time of the runs reaching the target
+		}
+		line.precision(0);
+		if (summary.time > 0.) line << " | IT/S " << summary.nbIterations / summary.time << " | LS/S " << summary.nbLocalSearches / summary.time;
+		std::cout << line.str() << std::endl;
+	}
+}
+
+std::string Benchmark::serialize() const
+{
+	std::string output = "{\"targetGaps\":[";
+	for (size_t k = 0; k < Batch::targetGaps.size(); k++)
+	{
+		if (k) output += ",";
+		JsonValue::appendNumber(output, Batch::targetGaps[k]);
+	}
+	output += "],\n\"overall\":" + serializeSummary(summaries[0]) + ",\n\"instances\":[";
+	for (size_t s = 1; s < summaries.size(); s++) output += ((s > 1) ? ",\n" : "\n") + serializeSummary(summaries[s]);
+	output += "],\n\"runs\":[";
+	for (size_t r = 0; r < results.size(); r++) output += (r ? ",\n" : "\n") + Batch::serializeResult(results[r], true);
+	output += "]}\n";
+	return output;
+}
+
+bool Benchmark::compareWithBaseline(const std::string & pathBaseline, double tolerance) const
+{
+	std::ifstream inputFile(pathBaseline);
+	if (!inputFile.is_open()) throw std::string("Impossible to open the baseline: " + pathBaseline);
+	std::stringstream document;
+	document << inputFile.rdbuf();
+	JsonValue baseline = JsonValue::parse(document.str());
+
+	// Summaries of the baseline by name (the summary over all runs included)
+	std::map <std::string, const JsonValue *> baselineSummaries;
+	const JsonValue * overall = baseline.find("overall");
+	const JsonValue * instances = baseline.find("instances");
+	if (overall == nullptr || instances == nullptr) throw std::string("The baseline is not the summary of a benchmark: " + pathBaseline);
+	baselineSummaries[getMember(*overall, "instance").getString()] = overall;
+	for (const JsonValue & instance : instances->getArray()) baselineSummaries[getMember(instance, "instance").getString()] = &instance;
+
+	std::cout << "----- COMPARISON WITH THE BASELINE " << pathBaseline << " (TOLERANCE " << tolerance << "%)" << std::endl;
+	bool isRegression = false;
+	for (size_t s = 0; s < summaries.size(); s++)
+	{
+		const Summary & summary = summaries[(s + 1) % summaries.size()];
+		auto found = baselineSummaries.find(summary.name);
+		if (found == baselineSummaries.end() || summary.time <= 0.) continue;
+		const JsonValue & reference = *found->second;
+
+		// Relative changes of the throughput, in percent
+		double changeIterations = 100. * (summary.nbIterations / summary.time / getMember(reference, "iterationsPerSecond").getNumber() - 1.);
+		double changeLocalSearches = 100. * (summary.nbLocalSearches / summary.time / getMember(reference, "localSearchesPerSecond").getNumber() - 1.);
+		bool isSlower = (changeIterations < -tolerance || changeLocalSearches < -tolerance);
+		char line[256];
+		std::snprintf(line, sizeof(line), "----- %s | IT/S %+.1f%% | LS/S %+.1f%%", summary.name.c_str(), changeIterations, changeLocalSearches);
+		std::string trace = line;
+		const JsonValue * referenceGap = reference.find("averageGap");
+		if (summary.nbGaps > 0 && referenceGap != nullptr && referenceGap->type == JsonValue::NUMBER)
+		{
+			std::snprintf(line, sizeof(line), " | GAP %.2f%% (BASELINE %.2f%%)", summary.sumGaps / summary.nbGaps, referenceGap->getNumber());
+			trace += line;
+		}
+		if (isSlower) trace += " | SLOWER";
+		std::cout << trace << std::endl;
+
+		// Only the throughput over all runs decides of a regression, the throughput of each instance being noisier
+		if (s + 1 == summaries.size() && isSlower) isRegression = true;
+	}
+	std::cout << (isRegression ? "----- THROUGHPUT REGRESSION" : "----- NO THROUGHPUT REGRESSION") << std::endl;
+	return !isRegression;
+}
+
+Benchmark::Benchmark(const std::vector <BatchResult> & results) : results(results)
+{
+	// Summary over all runs, and summaries of the instances by name
+	std::map <std::string, Summary> instances;
+	Summary overall;
+	overall.name = "overall";
+	for (const BatchResult & result : results)
+	{
+		addResult(overall, result);
+		Summary & instance = instances[result.name];
+		instance.name = result.name;
+		addResult(instance, result);
+	}
+	summaries.push_back(overall);
+	for (const std::pair <const std::string, Summary> & instance : instances) summaries.push_back(instance.second);
+}
@@ -0,0 +1,56 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "Batch.h"
+#include <string>
+#include <vector>
+
+// Benchmark (hgs_bench): summarizes the runs of a batch on instances with known BKS values, to follow the quality and the speed of the searches
+// For each instance and over all runs: gaps to the BKS, time-to-target curves (times at which the runs reach each target gap), and throughput in iterations and local searches per second
+// The summary is written as JSON, and can be compared with the summary of a previous benchmark (baseline) to detect the throughput regressions
+class Benchmark
+{
+private:
+
+	// Summary of the runs of an instance, or of all runs
+	struct Summary
+	{
+		std::string name;								// Name of the instance ("overall" for all runs)
+		int nbRuns = 0;									// Number of runs
+		int nbSolved = 0;								// Number of runs which found a solution
+		int nbGaps = 0;									// Number of runs with a solution and a known BKS
+		double sumGaps = 0.;							// Sum of the gaps of these runs (in percent)
+		double bestGap = 1.e30;							// Smallest gap of these runs
+		double time = 0.;								// Total time of the runs
+		long long nbIterations = 0;						// Total number of iterations
+		long long nbLocalSearches = 0;					// Total number of local searches
+		int nbTargetRuns = 0;							// Number of runs with a known BKS
+		std::vector < std::vector <double> > timesToTarget;	// For each target gap, sorted times at which the runs reached it
+	};
+
+	std::vector <Summary> summaries;					// Summary over all runs, followed by the summaries of the instances (by name)
+	std::vector <BatchResult> results;					// Results of the runs
+
+	// Adds the results of a run to a summary
+	static void addResult(Summary & summary, const BatchResult & result);
+
+	// Serializes a summary as a JSON object
+	static std::string serializeSummary(const Summary & summary);
+
+public:
+
+	// Displays one line per instance, and the summary over all runs
+	void print() const;
+
+	// Summary as a JSON document, with the results of the runs
+	std::string serialize() const;
+
+	// Compares the throughput with the summary of a previous benchmark, and displays the differences
+	// Returns false if the throughput over all runs (iterations or local searches per second) is lower than the baseline by more than tolerance percent
+	bool compareWithBaseline(const std::string & pathBaseline, double tolerance) const;
+
+	// Constructor: results of the runs of a batch
+	Benchmark(const std::vector <BatchResult> & results);
+};
+
+#endif
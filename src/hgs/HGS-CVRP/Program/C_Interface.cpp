@@ -6,53 +6,182 @@
 #include "Population.h"
 #include "Params.h"
 #include "Genetic.h"
+#include "IslandModel.h"
+#include "Reoptimization.h"
+#include "Solver.h"
+#include "WorkStealingPool.h"
 #include <string>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <new>
 
-Solution *prepare_solution(Population &population, Params &params)
+// Error of the last failed call of each thread (the successful calls leave it unchanged)
+static thread_local int lastErrorCode = HGS_OK;
+static thread_local std::string lastErrorMessage;
+
+int set_last_error(int code, const std::string &message)
 {
-	// Preparing the best solution
-	Solution *sol = new Solution;
-	sol->time = (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC;
-
-	if (population.getBestFound() != nullptr) {
-		// Best individual
-		auto best = population.getBestFound();
-
-		// setting the cost
-		sol->cost = best->eval.penalizedCost;
-
-		// finding out the number of routes in the best individual
-		int n_routes = 0;
-		for (int k = 0; k < params.nbVehicles; k++)
-			if (!best->chromR[k].empty()) ++n_routes;
-
-		// filling out the route information
-		sol->n_routes = n_routes;
-		sol->routes = new SolutionRoute[n_routes];
-		for (int k = 0; k < n_routes; k++) {
-			sol->routes[k].length = (int)best->chromR[k].size();
-			sol->routes[k].path = new int[sol->routes[k].length];
-			std::copy(best->chromR[k].begin(), best->chromR[k].end(), sol->routes[k].path);
+	lastErrorCode = code;
+	lastErrorMessage = message;
+	return code;
+}
+
+// Converts the exception being handled into an error code of the calling thread, and returns this code
+// The library only writes the message to the standard output in verbose mode
+int record_current_exception(bool verbose)
+{
+	int code;
+	try { throw; }
+	catch (const std::string &e) { code = set_last_error(HGS_ERROR_INVALID_INPUT, e); }
+	catch (const std::bad_alloc &) { code = set_last_error(HGS_ERROR_OUT_OF_MEMORY, "Out of memory"); }
+	catch (const std::exception &e) { code = set_last_error(HGS_ERROR_INTERNAL, e.what()); }
+	catch (...) { code = set_last_error(HGS_ERROR_INTERNAL, "Unknown exception"); }
+	if (verbose) std::cout << "EXCEPTION | " << lastErrorMessage << std::endl;
+	return code;
+}
+
+extern "C" int hgs_last_error(void)
+{
+	return lastErrorCode;
+}
+
+extern "C" const char *hgs_last_error_message(void)
+{
+	return lastErrorMessage.c_str();
+}
+
+Solution *prepare_solution(const Individual *best, Params &params)
+{
+	// Number of routes and of visited clients
+	int n_routes = 0;
+	int n_nodes = 0;
+	if (best != nullptr) {
+		for (int k = 0; k < params.nbVehicles; k++) {
+			if (best->routeLength[k] == 0) continue;
+			++n_routes;
+			n_nodes += best->routeLength[k];
 		}
 	}
-	else {
-		sol->cost = 0.0;
-		sol->n_routes = 0;
-		sol->routes = nullptr;
+
+	// The solution, its routes, the route offsets and the nodes are stored in a single allocation, released by delete_solution
+	size_t routesStart = sizeof(Solution);
+	size_t offsetsStart = routesStart + n_routes * sizeof(SolutionRoute);
+	size_t nodesStart = offsetsStart + (n_routes + 1) * sizeof(int);
+	char *buffer = (char *)std::malloc(nodesStart + n_nodes * sizeof(int));
+	if (buffer == nullptr) throw std::bad_alloc();
+	Solution *sol = (Solution *)buffer;
+	sol->time = params.deadline.getElapsedTime();
+	sol->cost = (best != nullptr) ? best->eval.penalizedCost : 0.0;
+	sol->n_routes = n_routes;
+	sol->routes = (n_routes > 0) ? (SolutionRoute *)(buffer + routesStart) : nullptr;
+	sol->route_offsets = (int *)(buffer + offsetsStart);
+	sol->nodes = (int *)(buffer + nodesStart);
+
+	// Filling out the route information
+	sol->route_offsets[0] = 0;
+	if (best != nullptr) {
+		for (int k = 0, r = 0; k < params.nbVehicles; k++) {
+			if (best->routeLength[k] == 0) continue;
+			int *path = sol->nodes + sol->route_offsets[r];
+			std::copy(best->route(k), best->route(k) + best->routeLength[k], path);
+			sol->routes[r].length = best->routeLength[k];
+			sol->routes[r].path = path;
+			sol->route_offsets[r + 1] = sol->route_offsets[r] + best->routeLength[k];
+			r++;
+		}
 	}
 	return sol;
 }
 
+Solution *prepare_solution(Population &population, Params &params)
+{
+	return prepare_solution(population.getBestFound(), params);
+}
+
+// Routes of a solution
+std::vector<std::vector<int>> get_routes(const Solution *sol)
+{
+	std::vector<std::vector<int>> routes(sol->n_routes);
+	for (int r = 0; r < sol->n_routes; r++)
+		routes[r].assign(sol->routes[r].path, sol->routes[r].path + sol->routes[r].length);
+	return routes;
+}
+
+// Euclidean distances between the n nodes given by their coordinates (rounded to the nearest integer if isRoundingInteger)
+void compute_distance_matrix(int n, const double *x, const double *y, char isRoundingInteger, DistanceMatrix &distance_matrix)
+{
+	distance_matrix.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			double distance = std::sqrt((x[i] - x[j])*(x[i] - x[j]) + (y[i] - y[j])*(y[i] - y[j]));
+			if (isRoundingInteger)
+				distance = std::round(distance);
+			distance_matrix.set(i, j, distance);
+		}
+	}
+}
+
+// Updates a previous solution into a solution of the new instance (params), and prepares it
+// The new instance contains the customers of the previous instance (of previousN nodes) which have not been removed, in the same order, followed by the added customers
+Solution *run_reoptimization(Params &params, int previousN, const Solution *previousSolution, const int *removedCustomers, int nbRemoved)
+{
+	std::vector<int> newIndex = Reoptimization::getNewIndex(previousN, params.nbClients, std::vector<int>(removedCustomers, removedCustomers + nbRemoved));
+	Individual result(params, false);
+	LocalSearch localSearch(params);
+	Reoptimization reoptimization(params, localSearch);
+	reoptimization.run(result, get_routes(previousSolution), newIndex);
+	return prepare_solution(&result, params);
+}
+
+// Modifies some arc costs of the instance (params), and updates a previous solution of this instance accordingly
+// Used by the stateless reoptimize_cvrp_arc_costs, whose params are built for the call: the incremental update of the neighbor lists only pays off with the solver handle (hgs_update_arc_costs)
+Solution *run_arc_cost_update(Params &params, const Solution *previousSolution, const int *arcFrom, const int *arcTo, const double *arcCost, int nbArcs)
+{
+	std::vector<int> sameIndex(params.nbClients + 1);
+	for (int i = 0; i <= params.nbClients; i++) sameIndex[i] = i;
+	std::vector<ArcCostUpdate> updates(nbArcs);
+	for (int k = 0; k < nbArcs; k++) updates[k] = { arcFrom[k], arcTo[k], arcCost[k] };
+
+	Individual solution(params, false);
+	LocalSearch localSearch(params);
+	Reoptimization reoptimization(params, localSearch);
+	reoptimization.run(solution, get_routes(previousSolution), sameIndex);
+	reoptimization.updateArcCosts(solution, updates);
+	return prepare_solution(&solution, params);
+}
+
+// Runs HGS (with the island model or a shared population if several threads are requested) and prepares the best solution
+Solution *run_hgs(Params &params)
+{
+	if (params.ap.nbThreads > 1 && params.ap.parallelScheme == 0)
+	{
+		IslandModel solver(params);
+		solver.run();
+		return prepare_solution(solver.getBestIsland().population, params);
+	}
+	else
+	{
+		Genetic solver(params);
+		solver.run();
+		return prepare_solution(solver.population, params);
+	}
+}
+
 
 extern "C" Solution *solve_cvrp(
 	int n, double *x, double *y, double *serv_time, double *dem,
 	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint,
 	int max_nbVeh, const AlgorithmParameters *ap, char verbose)
 {
-	Solution *result;
+	Solution *result = nullptr;
 
 	try {
 		std::vector<double> x_coords(x, x + n);
@@ -60,29 +189,15 @@ extern "C" Solution *solve_cvrp(
 		std::vector<double> service_time(serv_time, serv_time + n);
 		std::vector<double> demands(dem, dem + n);
 
-		std::vector<std::vector<double> > distance_matrix(n, std::vector<double>(n));
-		for (int i = 0; i < n; i++)
-		{
-			for (int j = 0; j < n; j++)
-			{
-				distance_matrix[i][j] = std::sqrt(
-					(x_coords[i] - x_coords[j])*(x_coords[i] - x_coords[j])
-					+ (y_coords[i] - y_coords[j])*(y_coords[i] - y_coords[j])
-				);
-				if (isRoundingInteger)
-					distance_matrix[i][j] = std::round(distance_matrix[i][j]);
-			}
-		}
+		DistanceMatrix distance_matrix;
+		compute_distance_matrix(n, x, y, isRoundingInteger, distance_matrix);
 
 		Params params(x_coords,y_coords,distance_matrix,service_time,demands,vehicleCapacity,durationLimit,max_nbVeh,isDurationConstraint,verbose,*ap);
 
 		// Running HGS and returning the result
-		Genetic solver(params);
-		solver.run();
-		result = prepare_solution(solver.population, params);
+		result = run_hgs(params);
 	}
-	catch (const std::string &e) { std::cout << "EXCEPTION | " << e << std::endl; }
-	catch (const std::exception &e) { std::cout << "EXCEPTION | " << e.what() << std::endl; }
+	catch (...) { record_current_exception(verbose); }
 
 	return result;
 }
@@ -92,7 +207,7 @@ extern "C" Solution *solve_cvrp_dist_mtx(
 	double vehicleCapacity, double durationLimit, char isDurationConstraint,
 	int max_nbVeh, const AlgorithmParameters *ap, char verbose)
 {
-	Solution *result;
+	Solution *result = nullptr;
 	std::vector<double> x_coords;
 	std::vector<double> y_coords;
 
@@ -105,31 +220,333 @@ extern "C" Solution *solve_cvrp_dist_mtx(
 		std::vector<double> service_time(serv_time, serv_time + n);
 		std::vector<double> demands(dem, dem + n);
 
-		std::vector<std::vector<double> > distance_matrix(n, std::vector<double>(n));
-		for (int i = 0; i < n; i++) { // row
-			for (int j = 0; j < n; j++) { // column
-				distance_matrix[i][j] = dist_mtx[n * i + j];
-			}
-		}
+		// The row-major matrix of the caller is used without any copy (and copied only if arc costs are modified)
+		DistanceMatrix distance_matrix;
+		distance_matrix.borrow(dist_mtx, n, n);
 
 		Params params(x_coords,y_coords,distance_matrix,service_time,demands,vehicleCapacity,durationLimit,max_nbVeh,isDurationConstraint,verbose,*ap);
 		
 		// Running HGS and returning the result
-		Genetic solver(params);
-		solver.run();
-		result = prepare_solution(solver.population, params);
+		result = run_hgs(params);
 	}
-	catch (const std::string &e) { std::cout << "EXCEPTION | " << e << std::endl; }
-	catch (const std::exception &e) { std::cout << "EXCEPTION | " << e.what() << std::endl; }
+	catch (...) { record_current_exception(verbose); }
 
 	return result;
 }
 
 extern "C" void delete_solution(Solution *sol)
 {
-	for (int i = 0; i < sol->n_routes; ++i)
-		delete[] sol->routes[i].path;
+	std::free(sol);
+}
+
+// Solver handle of the C interface
+struct HGSSolver
+{
+	Solver solver;
+	HGSSolver(const AlgorithmParameters &ap, bool verbose) : solver(ap, verbose) {}
+};
+
+extern "C" HGSSolver *hgs_create(const AlgorithmParameters *ap, char verbose)
+{
+	try {
+		return new HGSSolver(*ap, verbose);
+	}
+	catch (...) { record_current_exception(verbose); }
+	return nullptr;
+}
+
+extern "C" int hgs_set_instance(
+	HGSSolver *solver, int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint, int max_nbVeh)
+{
+	try {
+		solver->solver.setInstance(n, x, y, dist_mtx, n, false, serv_time, dem, vehicleCapacity, durationLimit, isRoundingInteger, isDurationConstraint, max_nbVeh);
+		return HGS_OK;
+	}
+	catch (...) { return record_current_exception(solver->solver.isVerbose()); }
+}
+
+extern "C" int hgs_set_instance_view(
+	HGSSolver *solver, int n, double *x, double *y, const double *dist_mtx, int stride, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint, int max_nbVeh)
+{
+	try {
+		solver->solver.setInstance(n, x, y, dist_mtx, stride, true, serv_time, dem, vehicleCapacity, durationLimit, false, isDurationConstraint, max_nbVeh);
+		return HGS_OK;
+	}
+	catch (...) { return record_current_exception(solver->solver.isVerbose()); }
+}
+
+extern "C" Solution *hgs_solve(HGSSolver *solver)
+{
+	Solution *result = nullptr;
+	try {
+		const Individual *best = solver->solver.solve();
+		result = prepare_solution(best, *solver->solver.getParams());
+	}
+	catch (...) { record_current_exception(solver->solver.isVerbose()); }
+	return result;
+}
+
+extern "C" Solution *hgs_update_arc_costs(
+	HGSSolver *solver, const Solution *previousSolution, const int *arcFrom, const int *arcTo, const double *arcCost, int nbArcs)
+{
+	Solution *result = nullptr;
+	try {
+		std::vector<ArcCostUpdate> updates(nbArcs);
+		for (int k = 0; k < nbArcs; k++) updates[k] = { arcFrom[k], arcTo[k], arcCost[k] };
+		const Individual *solution = solver->solver.updateArcCosts(get_routes(previousSolution), updates);
+		result = prepare_solution(solution, *solver->solver.getParams());
+	}
+	catch (...) { record_current_exception(solver->solver.isVerbose()); }
+	return result;
+}
+
+extern "C" Solution *hgs_reoptimize(
+	HGSSolver *solver, int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint, int max_nbVeh,
+	const Solution *previousSolution, const int *removedCustomers, int nbRemoved)
+{
+	Solution *result = nullptr;
+	try {
+		const Individual *solution = solver->solver.reoptimize(n, x, y, dist_mtx, serv_time, dem, vehicleCapacity, durationLimit, isRoundingInteger, isDurationConstraint, max_nbVeh,
+			get_routes(previousSolution), std::vector<int>(removedCustomers, removedCustomers + nbRemoved));
+		result = prepare_solution(solution, *solver->solver.getParams());
+	}
+	catch (...) { record_current_exception(solver->solver.isVerbose()); }
+	return result;
+}
+
+extern "C" void hgs_destroy(HGSSolver *solver)
+{
+	delete solver;
+}
+
+// Thread pool running the asynchronous solves of the process, created at the first asynchronous solve and never released (the jobs may outlive any static object)
+static std::mutex poolMutex;
+static WorkStealingPool *solvePool = nullptr;
+static int solvePoolSize = 0;
+
+extern "C" int hgs_set_pool_size(int nbThreads)
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	if (nbThreads < 0) return set_last_error(HGS_ERROR_INVALID_INPUT, "The size of the pool should be non-negative");
+	if (solvePool != nullptr) return set_last_error(HGS_ERROR_INVALID_INPUT, "The pool has already been started by an asynchronous solve");
+	solvePoolSize = nbThreads;
+	return HGS_OK;
+}
+
+WorkStealingPool &get_solve_pool()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	if (solvePool == nullptr)
+	{
+		int nbThreads = solvePoolSize;
+		if (nbThreads == 0) nbThreads = (int)std::thread::hardware_concurrency();
+		solvePool = new WorkStealingPool(nbThreads);
+	}
+	return *solvePool;
+}
+
+// Asynchronous solve of the C interface, running the search of a solver handle on the thread pool
+struct HGSJob
+{
+	HGSSolver *solver;						// Solver handle used by the job
+	HGSProgressCallback callback;			// Function called on each new best solution (NULL if none)
+	void *userData;							// User data given to the callback
+	std::atomic<bool> isStopRequested;		// Ends the search as soon as possible
+	std::atomic<bool> isCancelled;			// Tells that the result is discarded
+	std::atomic<bool> isDone;				// Tells that the search has ended
+	std::mutex progressMutex;				// Protects bestCost and serializes the calls to the callback (the islands report their new best solutions concurrently)
+	double bestCost;						// Best cost reported so far
+	Solution *result;						// Solution of the job (NULL if cancelled or failed)
+	int errorCode;							// Error of the job (HGS_OK if none)
+	std::string errorMessage;				// Description of this error
+	std::mutex doneMutex;					// Protects the end of the job
+	std::condition_variable doneSignal;		// Signals the end of the job to hgs_job_wait
+};
+
+// Records a new best solution of a population of the job, and forwards it to the callback if it improves on the best solution of all populations
+void report_new_best(HGSJob *job, double cost, double time)
+{
+	std::lock_guard<std::mutex> lock(job->progressMutex);
+	if (cost >= job->bestCost - MY_EPSILON) return;
+	job->bestCost = cost;
+	if (job->callback != nullptr) job->callback(cost, time, job->userData);
+}
+
+// Runs the search of a job (task of the thread pool). A job cancelled before its start is not solved
+void run_job(HGSJob *job)
+{
+	try {
+		if (!job->isCancelled)
+		{
+			const Individual *best = job->solver->solver.solve();
+			if (!job->isCancelled) job->result = prepare_solution(best, *job->solver->solver.getParams());
+		}
+	}
+	catch (...) {
+		job->errorCode = record_current_exception(job->solver->solver.isVerbose());
+		job->errorMessage = lastErrorMessage;
+	}
+	job->solver->solver.setSearchControl(nullptr, nullptr);
+	std::lock_guard<std::mutex> lock(job->doneMutex);
+	job->isDone = true;
+	job->doneSignal.notify_all();
+}
+
+extern "C" HGSJob *hgs_solve_async(HGSSolver *solver, HGSProgressCallback callback, void *userData)
+{
+	HGSJob *job = nullptr;
+	try {
+		job = new HGSJob;
+		job->solver = solver;
+		job->callback = callback;
+		job->userData = userData;
+		job->isStopRequested = false;
+		job->isCancelled = false;
+		job->isDone = false;
+		job->bestCost = 1.e30;
+		job->result = nullptr;
+		job->errorCode = HGS_OK;
+		solver->solver.setSearchControl(&job->isStopRequested, [job](double cost, double time) { report_new_best(job, cost, time); });
+		get_solve_pool().submit([job]() { run_job(job); });
+		return job;
+	}
+	catch (...) { record_current_exception(solver->solver.isVerbose()); }
+	solver->solver.setSearchControl(nullptr, nullptr);
+	delete job;
+	return nullptr;
+}
+
+extern "C" double hgs_job_best_cost(HGSJob *job)
+{
+	std::lock_guard<std::mutex> lock(job->progressMutex);
+	return job->bestCost;
+}
+
+extern "C" int hgs_job_is_done(HGSJob *job)
+{
+	return job->isDone ? 1 : 0;
+}
+
+extern "C" void hgs_job_stop(HGSJob *job)
+{
+	job->isStopRequested = true;
+}
 
-	delete[] sol->routes;
-	delete sol;
-}
\ No newline at end of file
+extern "C" void hgs_job_cancel(HGSJob *job)
+{
+	job->isCancelled = true;
+	job->isStopRequested = true;
+}
+
+extern "C" Solution *hgs_job_wait(HGSJob *job)
+{
+	{
+		std::unique_lock<std::mutex> lock(job->doneMutex);
+		job->doneSignal.wait(lock, [job]() { return job->isDone.load(); });
+	}
+	Solution *result = job->result;
+	if (job->isCancelled && result != nullptr)
+	{
+		delete_solution(result);
+		result = nullptr;
+	}
+	if (job->errorCode != HGS_OK) set_last_error(job->errorCode, job->errorMessage);
+	delete job;
+	return result;
+}
+
+extern "C" Solution *reoptimize_cvrp(
+	int n, double *x, double *y, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint,
+	int max_nbVeh, const AlgorithmParameters *ap, char verbose,
+	int previousN, const Solution *previousSolution, const int *removedCustomers, int nbRemoved)
+{
+	Solution *result = nullptr;
+
+	try {
+		std::vector<double> x_coords(x, x + n);
+		std::vector<double> y_coords(y, y + n);
+		std::vector<double> service_time(serv_time, serv_time + n);
+		std::vector<double> demands(dem, dem + n);
+
+		DistanceMatrix distance_matrix;
+		compute_distance_matrix(n, x, y, isRoundingInteger, distance_matrix);
+
+		Params params(x_coords,y_coords,distance_matrix,service_time,demands,vehicleCapacity,durationLimit,max_nbVeh,isDurationConstraint,verbose,*ap);
+
+		// Updating the previous solution and returning the result
+		result = run_reoptimization(params, previousN, previousSolution, removedCustomers, nbRemoved);
+	}
+	catch (...) { record_current_exception(verbose); }
+
+	return result;
+}
+
+extern "C" Solution *reoptimize_cvrp_dist_mtx(
+	int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint,
+	int max_nbVeh, const AlgorithmParameters *ap, char verbose,
+	int previousN, const Solution *previousSolution, const int *removedCustomers, int nbRemoved)
+{
+	Solution *result = nullptr;
+	std::vector<double> x_coords;
+	std::vector<double> y_coords;
+
+	try {
+		if (x != nullptr && y != nullptr) {
+			x_coords = {x, x + n};
+			y_coords = {y, y + n};
+		}
+
+		std::vector<double> service_time(serv_time, serv_time + n);
+		std::vector<double> demands(dem, dem + n);
+
+		// The row-major matrix of the caller is used without any copy (and copied only if arc costs are modified)
+		DistanceMatrix distance_matrix;
+		distance_matrix.borrow(dist_mtx, n, n);
+
+		Params params(x_coords,y_coords,distance_matrix,service_time,demands,vehicleCapacity,durationLimit,max_nbVeh,isDurationConstraint,verbose,*ap);
+
+		// Updating the previous solution and returning the result
+		result = run_reoptimization(params, previousN, previousSolution, removedCustomers, nbRemoved);
+	}
+	catch (...) { record_current_exception(verbose); }
+
+	return result;
+}
+
+extern "C" Solution *reoptimize_cvrp_arc_costs(
+	int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint,
+	int max_nbVeh, const AlgorithmParameters *ap, char verbose,
+	const Solution *previousSolution, const int *arcFrom, const int *arcTo, const double *arcCost, int nbArcs)
+{
+	Solution *result = nullptr;
+	std::vector<double> x_coords;
+	std::vector<double> y_coords;
+
+	try {
+		if (x != nullptr && y != nullptr) {
+			x_coords = {x, x + n};
+			y_coords = {y, y + n};
+		}
+
+		std::vector<double> service_time(serv_time, serv_time + n);
+		std::vector<double> demands(dem, dem + n);
+
+		// The row-major matrix of the caller is used without any copy (and copied only if arc costs are modified)
+		DistanceMatrix distance_matrix;
+		distance_matrix.borrow(dist_mtx, n, n);
+
+		Params params(x_coords,y_coords,distance_matrix,service_time,demands,vehicleCapacity,durationLimit,max_nbVeh,isDurationConstraint,verbose,*ap);
+
+		// Updating the arc costs and the previous solution, and returning the result
+		result = run_arc_cost_update(params, previousSolution, arcFrom, arcTo, arcCost, nbArcs);
+	}
+	catch (...) { record_current_exception(verbose); }
+
+	return result;
+}
@@ -6,18 +6,35 @@
 #define C_INTERFACE_H
 #include "AlgorithmParameters.h"
 
+// Thread safety: the functions of this interface can be called concurrently from different threads, as long as each solver handle and each job is only used by one thread at a time
+// The library keeps no shared state between the solves, and only writes to the standard output in verbose mode
+
+// Error codes. A failed call returns NULL (or a negative code), and its error can be read by hgs_last_error and hgs_last_error_message in the same thread
+enum HGSStatus
+{
+	HGS_OK = 0,							// No error
+	HGS_ERROR_INVALID_INPUT = -1,		// Invalid instance or parameters
+	HGS_ERROR_OUT_OF_MEMORY = -2,		// Memory allocation failure
+	HGS_ERROR_INTERNAL = -3				// Unexpected error of the library
+};
+
 struct SolutionRoute
 {
 	int length;
 	int * path;
 };
 
+// A solution is stored in a single allocation, released by delete_solution
+// The clients of all routes are stored one route after the other in nodes, route r starting at nodes[route_offsets[r]] and ending before nodes[route_offsets[r+1]]
+// routes[r].path points to the same memory
 struct Solution
 {
 	double cost;
 	double time;
 	int n_routes;
 	struct SolutionRoute * routes;
+	int * route_offsets;
+	int * nodes;
 };
 
 #ifdef __cplusplus
@@ -28,6 +45,7 @@ struct Solution * solve_cvrp(
 	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint,
 	int max_nbVeh, const struct AlgorithmParameters* ap, char verbose);
 
+// dist_mtx is the row-major n x n distance matrix, read without any copy during the call (the same holds for the reoptimization functions below)
 #ifdef __cplusplus
 extern "C"
 #endif
@@ -36,10 +54,175 @@ struct Solution *solve_cvrp_dist_mtx(
 	double vehicleCapacity, double durationLimit, char isDurationConstraint,
 	int max_nbVeh, const struct AlgorithmParameters *ap, char verbose);
 
+// Updates a previous solution after a change of the set of customers, without a complete re-solve
+// The new instance (n nodes) contains the customers of the previous instance (previousN nodes) which have not been removed, in the same order, followed by the added customers
+// removedCustomers contains the indices, in the previous instance, of the nbRemoved customers which have been removed
+// The added customers are inserted at their cheapest position, and the modified routes are improved by a local search (within ap->timeLimit if set)
+// These functions are stateless: the instance and its neighbor lists are rebuilt at each call. For a sequence of changes, hgs_reoptimize keeps the instance in a solver handle
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *reoptimize_cvrp(
+	int n, double* x, double* y, double* serv_time, double* dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint,
+	int max_nbVeh, const struct AlgorithmParameters* ap, char verbose,
+	int previousN, const struct Solution* previousSolution, const int* removedCustomers, int nbRemoved);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *reoptimize_cvrp_dist_mtx(
+	int n, double* x, double* y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint,
+	int max_nbVeh, const struct AlgorithmParameters *ap, char verbose,
+	int previousN, const struct Solution* previousSolution, const int* removedCustomers, int nbRemoved);
+
+// Updates a previous solution after a change of some arc costs (e.g., traffic updates), without a complete re-solve
+// dist_mtx is the distance matrix of the previous solution, and the arc (arcFrom[k], arcTo[k]) takes the new cost arcCost[k] for k < nbArcs
+// The routes containing a modified arc (or a client of an arc whose cost decreased) are improved by a local search
+// This function is stateless: the instance and its neighbor lists are rebuilt from dist_mtx at each call, which costs as much as loading the instance
+// For successive updates of the same instance, hgs_update_arc_costs keeps the instance in a solver handle and only recomputes the neighbor lists of the modified rows
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *reoptimize_cvrp_arc_costs(
+	int n, double* x, double* y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint,
+	int max_nbVeh, const struct AlgorithmParameters *ap, char verbose,
+	const struct Solution* previousSolution, const int* arcFrom, const int* arcTo, const double* arcCost, int nbArcs);
+
 #ifdef __cplusplus
 extern "C"
 #endif
 void delete_solution(struct Solution * sol);
 
+// Code of the last error of the calling thread (HGS_OK if no call has failed in this thread). Successful calls leave it unchanged
+#ifdef __cplusplus
+extern "C"
+#endif
+int hgs_last_error(void);
+
+// Description of the last error of the calling thread (empty if none), valid until the next failed call of this thread
+#ifdef __cplusplus
+extern "C"
+#endif
+const char *hgs_last_error_message(void);
+
+// Reusable solver handle, for applications solving many instances in a row
+// The memory of the instance data and of the search structures is kept between the solves, and the neighbor lists are only recomputed when the distances change
+// The search structures are reused as long as the number of nodes and the fleet size do not change
+// A handle should only be used by one thread at a time
+struct HGSSolver;
+
+// Creates a solver handle with the given parameters of the algorithm (NULL in case of error)
+#ifdef __cplusplus
+extern "C"
+#endif
+struct HGSSolver *hgs_create(const struct AlgorithmParameters *ap, char verbose);
+
+// Loads an instance of n nodes (depot at index 0) in the solver, replacing the previous one. Returns HGS_OK on success, or an error code (HGS_ERROR_INVALID_INPUT if the instance is invalid)
+// The distances are copied from the row-major matrix dist_mtx if it is not NULL, or computed from the coordinates otherwise (x and y may be NULL if dist_mtx is given)
+#ifdef __cplusplus
+extern "C"
+#endif
+int hgs_set_instance(
+	struct HGSSolver *solver, int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint, int max_nbVeh);
+
+// Loads an instance in the solver like hgs_set_instance, but uses the distance matrix of the caller without any copy: row i starts at dist_mtx + i * stride (stride >= n)
+// The matrix is never written, and should remain valid and unchanged until the next instance is loaded or the solver is destroyed (hgs_update_arc_costs then works on a copy)
+// The neighbor lists are always recomputed, since a modification of the matrix by the caller cannot be detected
+#ifdef __cplusplus
+extern "C"
+#endif
+int hgs_set_instance_view(
+	struct HGSSolver *solver, int n, double *x, double *y, const double *dist_mtx, int stride, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isDurationConstraint, int max_nbVeh);
+
+// Runs HGS on the current instance of the solver (NULL in case of error). The solution should be released by delete_solution
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *hgs_solve(struct HGSSolver *solver);
+
+// Modifies some arc costs of the current instance of the solver (the change persists for the next solves), and updates a previous solution of this instance accordingly (see reoptimize_cvrp_arc_costs)
+// Only the neighbor lists of the rows containing a modified arc are recomputed. If an update is invalid (index out of range, cost negative or not finite, or distances of invalid scale), none is applied
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *hgs_update_arc_costs(
+	struct HGSSolver *solver, const struct Solution *previousSolution, const int *arcFrom, const int *arcTo, const double *arcCost, int nbArcs);
+
+// Replaces the current instance of the solver by a modification of it after a change of the set of customers, and updates a previous solution of the current instance (see reoptimize_cvrp)
+// The new instance (n nodes, given like in hgs_set_instance) contains the customers of the current instance which have not been removed, in the same order, followed by the added customers
+// The distances between the kept nodes should be unchanged: the neighbor lists of the current instance are then updated rather than recomputed
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *hgs_reoptimize(
+	struct HGSSolver *solver, int n, double *x, double *y, double *dist_mtx, double *serv_time, double *dem,
+	double vehicleCapacity, double durationLimit, char isRoundingInteger, char isDurationConstraint, int max_nbVeh,
+	const struct Solution *previousSolution, const int *removedCustomers, int nbRemoved);
+
+// Releases a solver handle
+#ifdef __cplusplus
+extern "C"
+#endif
+void hgs_destroy(struct HGSSolver *solver);
+
+// Asynchronous solve: HGS runs on the current instance of a solver handle in a background thread, and the caller gets a job handle
+// The solver handle should not be used until the job has been waited for
+// The jobs of the process share one work-stealing thread pool: when more jobs are submitted than the pool has threads, the remaining jobs wait for a free thread (their time limit starts with their search)
+struct HGSJob;
+
+// Sets the number of threads of the pool running the asynchronous solves (0 for the number of hardware threads, the default)
+// Returns HGS_OK, or HGS_ERROR_INVALID_INPUT if the pool has already been started by an asynchronous solve
+#ifdef __cplusplus
+extern "C"
+#endif
+int hgs_set_pool_size(int nbThreads);
+
+// Function called on each new best solution of an asynchronous solve, with its cost, the time elapsed since the start of the search in seconds, and the user data given to hgs_solve_async
+// It is called from the threads of the search (one call at a time), and should return quickly (in particular, it should not wait for another job)
+typedef void (*HGSProgressCallback)(double cost, double time, void *userData);
+
+// Starts an asynchronous solve (NULL in case of error). The callback may be NULL
+#ifdef __cplusplus
+extern "C"
+#endif
+struct HGSJob *hgs_solve_async(struct HGSSolver *solver, HGSProgressCallback callback, void *userData);
+
+// Cost of the best solution found so far by the job (1.e30 if none yet)
+#ifdef __cplusplus
+extern "C"
+#endif
+double hgs_job_best_cost(struct HGSJob *job);
+
+// Tells if the search of the job has ended (1) or not (0)
+#ifdef __cplusplus
+extern "C"
+#endif
+int hgs_job_is_done(struct HGSJob *job);
+
+// Ends the search as soon as possible and keeps its best solution ("return best now")
+// The search stops within the next local search check (every 64 clients) or iteration of the genetic algorithm
+#ifdef __cplusplus
+extern "C"
+#endif
+void hgs_job_stop(struct HGSJob *job);
+
+// Ends the search as soon as possible and discards its result
+#ifdef __cplusplus
+extern "C"
+#endif
+void hgs_job_cancel(struct HGSJob *job);
+
+// Waits for the end of the job, releases it, and returns its solution (NULL if the job was cancelled or failed), to be released by delete_solution
+// If the search failed, its error becomes the last error of the calling thread
+#ifdef __cplusplus
+extern "C"
+#endif
+struct Solution *hgs_job_wait(struct HGSJob *job);
+
 
 #endif //C_INTERFACE_H
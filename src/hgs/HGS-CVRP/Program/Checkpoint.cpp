@@ -0,0 +1,71 @@
+#include "Checkpoint.h"
+#include <cstdio>
+
+volatile std::sig_atomic_t Checkpoint::requestedAction = 0;
+
+static void handleSignal(int signal)
+{
+	if (signal == SIGINT || signal == SIGTERM)
+	{
+		Checkpoint::requestedAction = 2;
+		std::signal(signal, SIG_DFL); // A second signal terminates the program immediately
+	}
+	else if (Checkpoint::requestedAction == 0)
+		Checkpoint::requestedAction = 1;
+}
+
+void Checkpoint::installSignalHandlers()
+{
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+#ifdef SIGUSR1
+	std::signal(SIGUSR1, handleSignal);
+#endif
+}
+
+bool Checkpoint::isDue() const
+{
+	return requestedAction != 0 || (interval > 0 && std::chrono::duration<double>(Deadline::Clock::now() - lastSnapshotTime).count() >= interval);
+}
+
+void Checkpoint::writeFile()
+{
+	std::string temporaryFileName = fileName + ".tmp";
+	std::ofstream myfile(temporaryFileName, std::ios::binary);
+	myfile.write(buffer.data(), (std::streamsize)buffer.size());
+	myfile.close();
+	if (!myfile) std::cout << "----- IMPOSSIBLE TO WRITE SNAPSHOT: " << temporaryFileName << std::endl;
+	else if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+	{
+		// Some systems do not allow to replace an existing file
+		std::remove(fileName.c_str());
+		if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0) std::cout << "----- IMPOSSIBLE TO WRITE SNAPSHOT: " << fileName << std::endl;
+	}
+}
+
+void Checkpoint::save(Population & population, int nbIter, int nbIterNonProd)
+{
+	if (isWriting && !isStopRequested()) return;
+	if (writer.joinable()) writer.join();
+
+	population.writeSnapshot(buffer, nbIter, nbIterNonProd);
+	lastSnapshotTime = Deadline::Clock::now();
+	if (requestedAction == 1) requestedAction = 0;
+
+	isWriting = true;
+	writer = std::thread([this]()
+	{
+		writeFile();
+		isWriting = false;
+	});
+}
+
+Checkpoint::Checkpoint(std::string fileName, double interval) : isWriting(false), fileName(fileName), interval(interval)
+{
+	lastSnapshotTime = Deadline::Clock::now();
+}
+
+Checkpoint::~Checkpoint()
+{
+	if (writer.joinable()) writer.join();
+}
@@ -0,0 +1,50 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "Population.h"
+#include <thread>
+#include <atomic>
+#include <csignal>
+
+// Periodic (and signal-triggered) snapshots of the population, allowing to resume a long run after an interruption
+// The population is serialized in memory by the search thread, and the file is written by a background thread
+class Checkpoint
+{
+private:
+
+	std::vector <char> buffer;							// Serialized snapshot being written
+	std::thread writer;									// Background thread writing the snapshot
+	std::atomic <bool> isWriting;						// Tells if the background thread is still writing the previous snapshot
+	Deadline::Clock::time_point lastSnapshotTime;		// Time of the last snapshot
+
+	// Writes the buffer in a temporary file which then replaces the snapshot file, such that an interruption never leaves an incomplete snapshot
+	void writeFile();
+
+public:
+
+	std::string fileName;								// Path of the snapshot file
+	double interval;									// Wall-clock time between two snapshots in seconds (0 = only on signals)
+
+	static volatile std::sig_atomic_t requestedAction;	// Action requested by a signal: 0 = none, 1 = snapshot, 2 = snapshot and stop the search
+
+	// Installs the signal handlers: SIGINT and SIGTERM request a last snapshot and stop the search, SIGUSR1 (if available) requests a snapshot
+	static void installSignalHandlers();
+
+	// Tells if a snapshot is due (interval elapsed or signal received)
+	bool isDue() const;
+
+	// Tells if a signal requested to stop the search
+	bool isStopRequested() const { return requestedAction == 2; }
+
+	// Serializes the population (and the search counters) and writes it asynchronously
+	// If the previous snapshot is still being written, the snapshot is postponed (unless the search stops)
+	void save(Population & population, int nbIter, int nbIterNonProd);
+
+	// Constructor
+	Checkpoint(std::string fileName, double interval);
+
+	// Destructor: waits until the last snapshot is written
+	~Checkpoint();
+};
+
+#endif
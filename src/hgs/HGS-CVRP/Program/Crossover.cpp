@@ -0,0 +1,115 @@
+#include "Crossover.h"
+
+void Crossover::run(Individual & result, const Individual & parent1, const Individual & parent2)
+{
+	if (params.ap.crossoverType == 1) crossoverSREX(result, parent1, parent2);
+	else crossoverOX(result, parent1, parent2);
+}
+
+void Crossover::crossoverOX(Individual & result, const Individual & parent1, const Individual & parent2)
+{
+	// Frequency table to track the customers which have been already inserted
+	std::fill(freqClient.begin(), freqClient.end(), false);
+
+	// Picking the beginning and end of the crossover zone
+	std::uniform_int_distribution<> distr(0, params.nbClients-1);
+	int start = distr(params.ran);
+	int end = distr(params.ran);
+
+	// Avoid that start and end coincide by accident
+	while (end == start) end = distr(params.ran);
+
+	// Copy from start to end
+	int j = start;
+	while (j % params.nbClients != (end + 1) % params.nbClients)
+	{
+		result.chromT[j % params.nbClients] = parent1.chromT[j % params.nbClients];
+		freqClient[result.chromT[j % params.nbClients]] = true;
+		j++;
+	}
+
+	// Fill the remaining elements in the order given by the second parent
+	for (int i = 1; i <= params.nbClients; i++)
+	{
+		int temp = parent2.chromT[(end + i) % params.nbClients];
+		if (freqClient[temp] == false)
+		{
+			result.chromT[j % params.nbClients] = temp;
+			j++;
+		}
+	}
+
+	// Complete the individual with the Split algorithm
+	split.generalSplit(result, parent1.eval.nbRoutes);
+}
+
+void Crossover::crossoverSREX(Individual & result, const Individual & parent1, const Individual & parent2)
+{
+	// Route of each client in the first parent, and number of exchanged routes
+	for (int r = 0; r < params.nbVehicles; r++)
+		for (int k = 0; k < parent1.routeLength[r]; k++) routeOf1[parent1.route(r)[k]] = r;
+	int maxSelected = std::max<int>(1, std::min<int>(parent1.eval.nbRoutes, parent2.eval.nbRoutes) / 2);
+	int nbSelected = 1 + (int)(params.ran() % maxSelected);
+
+	// Selecting close routes of the first parent: the routes of the clients reached by a breadth-first search from a random client in the graph of the nearest vertices
+	std::fill(isSelected.begin(), isSelected.end(), false);
+	std::fill(isReached.begin(), isReached.end(), false);
+	reachedClients.clear();
+	int startClient = 1 + (int)(params.ran() % params.nbClients);
+	reachedClients.push_back(startClient);
+	isReached[startClient] = true;
+	int nbSelectedSoFar = 0;
+	for (int q = 0; q < (int)reachedClients.size() && nbSelectedSoFar < nbSelected; q++)
+	{
+		int client = reachedClients[q];
+		if (!isSelected[routeOf1[client]]) { isSelected[routeOf1[client]] = true; nbSelectedSoFar++; }
+		for (int j : params.nearestVertices[client])
+			if (!isReached[j]) { isReached[j] = true; reachedClients.push_back(j); }
+	}
+
+	// Customers of the selected routes, and routes of the second parent ordered by decreasing number of these customers
+	std::fill(isInSelectedRoutes.begin(), isInSelectedRoutes.end(), false);
+	for (int r = 0; r < params.nbVehicles; r++)
+		if (isSelected[r])
+			for (int k = 0; k < parent1.routeLength[r]; k++) isInSelectedRoutes[parent1.route(r)[k]] = true;
+	overlaps.clear();
+	for (int r = 0; r < params.nbVehicles; r++)
+	{
+		if (parent2.routeLength[r] == 0) continue;
+		int overlap = 0;
+		for (int k = 0; k < parent2.routeLength[r]; k++) overlap += isInSelectedRoutes[parent2.route(r)[k]];
+		overlaps.push_back({ -overlap, r });
+	}
+	int nbInserted = std::min<int>(nbSelectedSoFar, (int)overlaps.size());
+	std::partial_sort(overlaps.begin(), overlaps.begin() + nbInserted, overlaps.end());
+
+	// Offspring: routes of the first parent which are not selected, and best routes of the second parent restricted to the customers of the selected routes
+	int nbOffspringRoutes = 0;
+	for (int r = 0; r < params.nbVehicles; r++)
+		if (parent1.routeLength[r] > 0 && !isSelected[r])
+			offspringRoutes[nbOffspringRoutes++].assign(parent1.route(r), parent1.route(r) + parent1.routeLength[r]);
+	for (int k = 0; k < nbInserted; k++)
+	{
+		int r = overlaps[k].second;
+		std::vector <int> & offspringRoute = offspringRoutes[nbOffspringRoutes++];
+		offspringRoute.clear();
+		for (int i = 0; i < parent2.routeLength[r]; i++)
+			if (isInSelectedRoutes[parent2.route(r)[i]]) offspringRoute.push_back(parent2.route(r)[i]);
+	}
+	for (int r = nbOffspringRoutes; r < params.nbVehicles; r++) offspringRoutes[r].clear();
+
+	// Cheapest insertion of the customers of the selected routes which are not visited by these routes of the second parent
+	reoptimization.completeRoutes(result, offspringRoutes);
+}
+
+Crossover::Crossover(Params & params, Split & split, Reoptimization & reoptimization) : params(params), split(split), reoptimization(reoptimization)
+{
+	freqClient = std::vector <char>(params.nbClients + 1, false);
+	routeOf1 = std::vector <int>(params.nbClients + 1, 0);
+	isSelected = std::vector <char>(params.nbVehicles, false);
+	isReached = std::vector <char>(params.nbClients + 1, false);
+	reachedClients.reserve(params.nbClients);
+	isInSelectedRoutes = std::vector <char>(params.nbClients + 1, false);
+	overlaps.reserve(params.nbVehicles);
+	offspringRoutes = std::vector < std::vector <int> >(params.nbVehicles);
+}
@@ -0,0 +1,42 @@
+#ifndef CROSSOVER_H
+#define CROSSOVER_H
+
+#include "Split.h"
+#include "Reoptimization.h"
+
+// Crossover operators of the genetic algorithm
+// Each thread owns its crossover structure, whose buffers are allocated once, such that generating an offspring does not allocate memory
+class Crossover
+{
+private:
+
+	Params & params;										// Problem parameters (random number generator of the thread)
+	Split & split;											// Split algorithm
+	Reoptimization & reoptimization;						// Cheapest insertions used by the route-based crossover
+	std::vector <char> freqClient;							// (OX) Tells which customers have already been inserted
+	std::vector <int> routeOf1;								// (SREX) Route of each client in the first parent
+	std::vector <char> isSelected;							// (SREX) Tells which routes of the first parent are replaced
+	std::vector <char> isReached;							// (SREX) Clients reached by the breadth-first search
+	std::vector <int> reachedClients;						// (SREX) Queue of the breadth-first search
+	std::vector <char> isInSelectedRoutes;					// (SREX) Tells which clients belong to the replaced routes
+	std::vector < std::pair <int, int> > overlaps;			// (SREX) Routes of the second parent with their number of clients in the replaced routes (negated for sorting)
+	std::vector < std::vector <int> > offspringRoutes;		// (SREX) Routes of the offspring before the insertion of the missing customers (the unused routes are empty)
+
+public:
+
+	// Crossover selected by ap.crossoverType
+	void run(Individual & result, const Individual & parent1, const Individual & parent2);
+
+	// OX Crossover
+	void crossoverOX(Individual & result, const Individual & parent1, const Individual & parent2);
+
+	// SREX Crossover (selective route exchange): a group of close routes of parent1 is replaced by the routes of parent2 which visit most of their customers
+	// The customers of these routes of parent2 which are already visited by the other routes of parent1 are skipped, and the missing customers are inserted at their cheapest position
+	// Unlike OX, the other routes of parent1 are kept as they are, such that the local search has much less to repair
+	void crossoverSREX(Individual & result, const Individual & parent1, const Individual & parent2);
+
+	// Constructor
+	Crossover(Params & params, Split & split, Reoptimization & reoptimization);
+};
+
+#endif
@@ -0,0 +1,387 @@
+#include "Daemon.h"
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <new>
+#ifndef _WIN32
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+// Tells if a parameter can change without rebuilding a solver (see Solver::setSearchLimits)
+static bool isSearchLimit(const AlgorithmParameterField & field)
+{
+	return field.intField == &AlgorithmParameters::seed || field.intField == &AlgorithmParameters::nbIter || field.doubleField == &AlgorithmParameters::timeLimit;
+}
+
+void Daemon::respond(Session & session, const std::string & line)
+{
+#ifndef _WIN32
+	std::lock_guard <std::mutex> lock(session.outputMutex);
+	std::string output = line + "\n";
+	size_t written = 0;
+	while (written < output.size())
+	{
+		ssize_t result = ::write(session.outputFd, output.data() + written, output.size() - written);
+		if (result < 0 && errno == EINTR) continue;
+		if (result <= 0) return; // The other end has been closed: the response is dropped
+		written += result;
+	}
+#endif
+}
+
+void Daemon::respondError(Session & session, const std::string & id, const std::string & code, const std::string & message)
+{
+	std::string line = "{\"id\":" + id + ",\"event\":\"error\",\"code\":";
+	JsonValue::appendString(line, code);
+	line += ",\"message\":";
+	JsonValue::appendString(line, message);
+	respond(session, line + "}");
+}
+
+std::unique_ptr <Solver> Daemon::acquireSolver(const std::string & cacheKey, const AlgorithmParameters & ap)
+{
+	{
+		std::lock_guard <std::mutex> lock(cacheMutex);
+		for (auto it = idleSolvers.begin(); it != idleSolvers.end(); ++it)
+		{
+			if (it->first != cacheKey) continue;
+			std::unique_ptr <Solver> solver = std::move(it->second);
+			idleSolvers.erase(it);
+			return solver;
+		}
+	}
+	return std::unique_ptr <Solver>(new Solver(ap, false));
+}
+
+void Daemon::releaseSolver(const std::string & cacheKey, std::unique_ptr <Solver> solver)
+{
+	std::unique_ptr <Solver> evictedSolver; // Released outside of the lock
+	std::lock_guard <std::mutex> lock(cacheMutex);
+	idleSolvers.emplace_front(cacheKey, std::move(solver));
+	if ((int)idleSolvers.size() > cacheSize)
+	{
+		evictedSolver = std::move(idleSolvers.back().second);
+		idleSolvers.pop_back();
+	}
+}
+
+std::shared_ptr <Daemon::Job> Daemon::readJob(const JsonValue & request, const std::string & id)
+{
+	std::shared_ptr <Job> job(new Job);
+	job->id = id;
+
+	// Parameters of the search: those of the line of command, overridden by those of the request
+	// The cache key contains the parameters which are fixed for the lifetime of a solver
+	job->ap = defaultAp;
+	const JsonValue * params = request.find("params");
+	if (params != nullptr)
+	{
+		if (params->type != JsonValue::OBJECT) throw std::string("The parameters should be an object");
+		for (const std::pair <std::string, JsonValue> & member : params->members)
+		{
+			const AlgorithmParameterField * parameter = find_algorithm_parameter(member.first.c_str());
+			if (parameter == nullptr) throw std::string("Unknown parameter: " + member.first);
+			if (parameter->intField != nullptr) job->ap.*(parameter->intField) = member.second.getInt();
+			else job->ap.*(parameter->doubleField) = member.second.getNumber();
+		}
+	}
+	const JsonValue * cache = request.find("cache");
+	if (cache != nullptr) JsonValue::appendString(job->cacheKey, cache->getString());
+	for (const AlgorithmParameterField * parameter = algorithmParameterFields; parameter->name != nullptr; parameter++)
+	{
+		if (isSearchLimit(*parameter)) continue;
+		job->cacheKey += std::string(",") + parameter->name + "=";
+		JsonValue::appendNumber(job->cacheKey, (parameter->intField != nullptr) ? job->ap.*(parameter->intField) : job->ap.*(parameter->doubleField));
+	}
+	const JsonValue * progress = request.find("progress");
+	job->isProgressReported = (progress != nullptr && progress->getBoolean());
+
+	// Data of the instance
+	const JsonValue * instance = request.find("instance");
+	if (instance == nullptr || instance->type != JsonValue::OBJECT) throw std::string("The request should contain an instance object");
+	const JsonValue * demands = instance->find("demands");
+	const JsonValue * capacity = instance->find("capacity");
+	if (demands == nullptr || capacity == nullptr) throw std::string("The instance should contain the demands and the capacity");
+	job->demands = demands->getNumbers();
+	job->nbNodes = (int)job->demands.size();
+	job->vehicleCapacity = capacity->getNumber();
+	const JsonValue * x = instance->find("x");
+	const JsonValue * y = instance->find("y");
+	if ((x == nullptr) != (y == nullptr)) throw std::string("Both coordinates x and y should be given");
+	if (x != nullptr)
+	{
+		job->x = x->getNumbers();
+		job->y = y->getNumbers();
+		if ((int)job->x.size() != job->nbNodes || (int)job->y.size() != job->nbNodes) throw std::string("The coordinates should have one value per node");
+	}
+	const JsonValue * distances = instance->find("distances");
+	if (distances != nullptr)
+	{
+		// Either an array of rows, or a flat row-major array
+		const std::vector <JsonValue> & values = distances->getArray();
+		if (!values.empty() && values[0].type == JsonValue::ARRAY)
+		{
+			if ((int)values.size() != job->nbNodes) throw std::string("The distance matrix should have one row per node");
+			job->distances.reserve((size_t)job->nbNodes * job->nbNodes);
+			for (const JsonValue & row : values)
+			{
+				if ((int)row.getArray().size() != job->nbNodes) throw std::string("The distance matrix should have one column per node");
+				for (const JsonValue & value : row.elements) job->distances.push_back(value.getNumber());
+			}
+		}
+		else
+		{
+			job->distances = distances->getNumbers();
+			if (job->distances.size() != (size_t)job->nbNodes * job->nbNodes) throw std::string("The distance matrix should have n x n values");
+		}
+	}
+	if (x == nullptr && distances == nullptr) throw std::string("Either the coordinates or the distance matrix should be provided");
+	const JsonValue * serviceTime = instance->find("service_times");
+	if (serviceTime != nullptr)
+	{
+		job->serviceTime = serviceTime->getNumbers();
+		if ((int)job->serviceTime.size() != job->nbNodes) throw std::string("The service times should have one value per node");
+	}
+	else job->serviceTime.assign(job->nbNodes, 0.);
+	const JsonValue * durationLimit = instance->find("duration_limit");
+	job->isDurationConstraint = (durationLimit != nullptr && durationLimit->type != JsonValue::NUL);
+	job->durationLimit = job->isDurationConstraint ? durationLimit->getNumber() : 1.e30;
+	const JsonValue * vehicles = instance->find("vehicles");
+	job->nbVehicles = (vehicles != nullptr) ? vehicles->getInt() : defaultNbVehicles;
+	const JsonValue * round = instance->find("round");
+	job->isRoundingInteger = (round != nullptr) ? round->getBoolean() : defaultIsRoundingInteger;
+	return job;
+}
+
+void Daemon::runJob(std::shared_ptr <Session> session, std::shared_ptr <Job> job)
+{
+	if (job->isCancelled) respond(*session, "{\"id\":" + job->id + ",\"event\":\"cancelled\"}");
+	else
+	{
+		std::unique_ptr <Solver> solver;
+		try
+		{
+			solver = acquireSolver(job->cacheKey, job->ap);
+			solver->setSearchLimits(job->ap.seed, job->ap.nbIter, job->ap.timeLimit);
+			solver->setInstance(job->nbNodes, job->x.empty() ? nullptr : job->x.data(), job->y.empty() ? nullptr : job->y.data(),
+				job->distances.empty() ? nullptr : job->distances.data(), job->nbNodes, false, job->serviceTime.data(), job->demands.data(),
+				job->vehicleCapacity, job->durationLimit, job->isRoundingInteger, job->isDurationConstraint, job->nbVehicles);
+
+			// Progress events for the improvements of the best solution over all islands
+			std::function <void(double, double)> onNewBestSolution;
+			if (job->isProgressReported)
+			{
+				Session * output = session.get();
+				Job * progressJob = job.get();
+				onNewBestSolution = [this, output, progressJob](double cost, double time)
+				{
+					std::lock_guard <std::mutex> lock(progressJob->progressMutex);
+					if (cost >= progressJob->bestCost - MY_EPSILON) return;
+					progressJob->bestCost = cost;
+					std::string line = "{\"id\":" + progressJob->id + ",\"event\":\"progress\",\"cost\":";
+					JsonValue::appendNumber(line, cost);
+					line += ",\"time\":";
+					JsonValue::appendNumber(line, time);
+					respond(*output, line + "}");
+				};
+			}
+			solver->setSearchControl(&job->isStopRequested, onNewBestSolution);
+			const Individual * best = solver->solve();
+			solver->setSearchControl(nullptr, nullptr);
+
+			if (job->isCancelled) respond(*session, "{\"id\":" + job->id + ",\"event\":\"cancelled\"}");
+			else if (best == nullptr) respondError(*session, job->id, "infeasible", "No feasible solution has been found");
+			else
+			{
+				Params & params = *solver->getParams();
+				std::string line = "{\"id\":" + job->id + ",\"event\":\"solution\",\"cost\":";
+				JsonValue::appendNumber(line, best->eval.penalizedCost);
+				line += ",\"time\":";
+				JsonValue::appendNumber(line, params.deadline.getElapsedTime());
+				line += ",\"routes\":[";
+				bool isFirstRoute = true;
+				for (int k = 0; k < params.nbVehicles; k++)
+				{
+					if (best->routeLength[k] == 0) continue;
+					line += isFirstRoute ? "[" : ",[";
+					for (int i = 0; i < best->routeLength[k]; i++) line += (i ? "," : "") + std::to_string(best->route(k)[i]);
+					line += "]";
+					isFirstRoute = false;
+				}
+				respond(*session, line + "]}");
+			}
+			releaseSolver(job->cacheKey, std::move(solver));
+		}
+		catch (const std::string & e) { respondError(*session, job->id, "invalid_input", e); }
+		catch (const std::bad_alloc &) { respondError(*session, job->id, "out_of_memory", "Out of memory"); }
+		catch (const std::exception & e) { respondError(*session, job->id, "internal", e.what()); }
+		if (solver) solver->setSearchControl(nullptr, nullptr);
+	}
+
+	std::lock_guard <std::mutex> lock(session->jobsMutex);
+	session->jobs.erase(job->id);
+	session->jobsDone.notify_all();
+}
+
+void Daemon::handleRequest(std::shared_ptr <Session> session, const std::string & line)
+{
+	std::string id = "null";
+	try
+	{
+		JsonValue request = JsonValue::parse(line);
+		if (request.type != JsonValue::OBJECT) throw std::string("A request should be a JSON object");
+		const JsonValue * idValue = request.find("id");
+		if (idValue != nullptr) id = idValue->serialize();
+		const JsonValue * typeValue = request.find("type");
+		std::string type = (typeValue != nullptr) ? typeValue->getString() : "solve";
+
+		if (type == "solve")
+		{
+			if (idValue == nullptr) throw std::string("A solve request should have an identifier");
+			std::shared_ptr <Job> job = readJob(request, id);
+			{
+				std::lock_guard <std::mutex> lock(session->jobsMutex);
+				if (session->jobs.count(id)) throw std::string("A request with the same identifier is still running");
+				session->jobs[id] = job;
+			}
+			pool.submit([this, session, job]() { runJob(session, job); });
+		}
+		else if (type == "stop" || type == "cancel")
+		{
+			// Stop: the search ends as soon as possible and its best solution is returned. Cancel: the search ends and its result is discarded
+			const JsonValue * target = request.find("target");
+			if (target == nullptr) throw std::string("The request should give the identifier of its target");
+			std::lock_guard <std::mutex> lock(session->jobsMutex);
+			auto it = session->jobs.find(target->serialize());
+			if (it == session->jobs.end()) throw std::string("No running request with this identifier");
+			if (type == "cancel") it->second->isCancelled = true;
+			it->second->isStopRequested = true;
+		}
+		else if (type == "shutdown") requestShutdown();
+		else throw std::string("Unknown request type: " + type);
+	}
+	catch (const std::string & e) { respondError(*session, id, "invalid_input", e); }
+	catch (const std::bad_alloc &) { respondError(*session, id, "out_of_memory", "Out of memory"); }
+	catch (const std::exception & e) { respondError(*session, id, "internal", e.what()); }
+}
+
+void Daemon::runSession(std::shared_ptr <Session> session)
+{
+#ifndef _WIN32
+	// Reading the requests line by line, until the end of the input or a shutdown
+	std::string pending;
+	std::vector <char> buffer(1 << 16);
+	while (!isShutdownRequested)
+	{
+		ssize_t nbRead = ::read(session->inputFd, buffer.data(), buffer.size());
+		if (nbRead < 0 && errno == EINTR) continue;
+		if (nbRead <= 0) break;
+		size_t lineStart = pending.size();
+		pending.append(buffer.data(), nbRead);
+		size_t searchStart = lineStart;
+		lineStart = 0;
+		size_t lineEnd;
+		while (!isShutdownRequested && (lineEnd = pending.find('\n', searchStart)) != std::string::npos)
+		{
+			std::string line = pending.substr(lineStart, lineEnd - lineStart);
+			if (line.find_first_not_of(" \t\r") != std::string::npos) handleRequest(session, line);
+			lineStart = lineEnd + 1;
+			searchStart = lineStart;
+		}
+		pending.erase(0, lineStart);
+	}
+	if (!isShutdownRequested && pending.find_first_not_of(" \t\r") != std::string::npos) handleRequest(session, pending);
+#endif
+
+	// The solves already submitted are completed and answered
+	std::unique_lock <std::mutex> lock(session->jobsMutex);
+	session->jobsDone.wait(lock, [&]() { return session->jobs.empty(); });
+}
+
+void Daemon::requestShutdown()
+{
+#ifndef _WIN32
+	isShutdownRequested = true;
+	std::lock_guard <std::mutex> lock(sessionsMutex);
+	for (std::shared_ptr <Session> & session : sessions) ::shutdown(session->inputFd, SHUT_RD);
+	if (listenFd >= 0) ::shutdown(listenFd, SHUT_RDWR);
+#endif
+}
+
+void Daemon::run(const std::string & endpoint)
+{
+#ifdef _WIN32
+	throw std::string("The daemon mode is only available on POSIX systems");
+#else
+	std::signal(SIGPIPE, SIG_IGN); // A client closing its connection early should not end the daemon
+	if (endpoint == "stdin")
+	{
+		// The standard output is reserved for the responses: anything else written to it goes to the standard error
+		int outputFd = ::dup(STDOUT_FILENO);
+		if (outputFd < 0 || ::dup2(STDERR_FILENO, STDOUT_FILENO) < 0) throw std::string("Unable to redirect the standard output");
+		std::shared_ptr <Session> session(new Session(STDIN_FILENO, outputFd));
+		runSession(session);
+		::close(outputFd);
+		return;
+	}
+
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (endpoint.size() >= sizeof(address.sun_path)) throw std::string("The path of the socket is too long");
+	std::strcpy(address.sun_path, endpoint.c_str());
+	listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0) throw std::string("Unable to create the socket");
+	::unlink(endpoint.c_str());
+	if (::bind(listenFd, (sockaddr *)&address, sizeof(address)) < 0 || ::listen(listenFd, 16) < 0)
+	{
+		::close(listenFd);
+		throw std::string("Unable to listen on the socket " + endpoint);
+	}
+
+	// Each connection is a session, read by its own thread, until a shutdown request
+	std::vector <std::thread> sessionThreads;
+	while (!isShutdownRequested)
+	{
+		int connectionFd = ::accept(listenFd, nullptr, nullptr);
+		if (connectionFd < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			break;
+		}
+		std::shared_ptr <Session> session(new Session(connectionFd, connectionFd));
+		{
+			std::lock_guard <std::mutex> lock(sessionsMutex);
+			if (isShutdownRequested) ::shutdown(connectionFd, SHUT_RD);
+			sessions.push_back(session);
+		}
+		sessionThreads.emplace_back([this, session]()
+		{
+			runSession(session);
+			std::lock_guard <std::mutex> lock(sessionsMutex);
+			::close(session->inputFd);
+			sessions.remove(session);
+		});
+	}
+	for (std::thread & thread : sessionThreads) thread.join();
+	::close(listenFd);
+	listenFd = -1;
+	::unlink(endpoint.c_str());
+#endif
+}
+
+Daemon::Daemon(const AlgorithmParameters & ap, int nbVehicles, bool isRoundingInteger, int nbWorkers, int cacheSize) :
+	defaultAp(ap),
+	defaultNbVehicles(nbVehicles),
+	defaultIsRoundingInteger(isRoundingInteger),
+	cacheSize(cacheSize),
+	pool((nbWorkers > 0) ? nbWorkers : (int)std::thread::hardware_concurrency()),
+	isShutdownRequested(false),
+	listenFd(-1)
+{
+}
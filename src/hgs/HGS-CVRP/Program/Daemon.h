@@ -0,0 +1,109 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "Solver.h"
+#include "WorkStealingPool.h"
+#include "Json.h"
+#include <list>
+#include <map>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+// Daemon mode of the executable: a long-running process solving the requests of a pipeline, without paying the process startup and the file input/output at each instance
+// The requests are read as NDJSON (one JSON object per line) from the standard input or from the connections of a Unix domain socket, and solved concurrently on a pool of worker threads
+// The responses (progress events and solutions) are streamed back on the same channel as NDJSON, each line tagged with the identifier of its request
+// The solvers are kept between the requests (see Solver), such that a request with the same cache key and parameters as a previous one reuses its memory, neighbor lists and search structures
+class Daemon
+{
+private:
+
+	// Solve request being processed
+	struct Job
+	{
+		std::string id;									// Serialized identifier of the request
+		std::string cacheKey;							// Key of the solvers which can be reused by this request
+		AlgorithmParameters ap;							// Parameters of the search
+		bool isProgressReported;						// Tells if the new best solutions are streamed as progress events
+		int nbNodes;									// Number of nodes (depot at index 0)
+		std::vector <double> x;							// X coordinates (empty if not provided)
+		std::vector <double> y;							// Y coordinates (empty if not provided)
+		std::vector <double> distances;					// Row-major distance matrix (empty if computed from the coordinates)
+		std::vector <double> serviceTime;				// Service durations
+		std::vector <double> demands;					// Demands
+		double vehicleCapacity;							// Capacity of the vehicles
+		double durationLimit;							// Route duration limit
+		bool isDurationConstraint;						// Tells if the duration limit is used
+		bool isRoundingInteger;							// Rounding of the distances computed from the coordinates
+		int nbVehicles;									// Number of vehicles
+		std::atomic <bool> isStopRequested;				// Ends the search as soon as possible
+		std::atomic <bool> isCancelled;					// Tells that the result is discarded
+		std::mutex progressMutex;						// Protects bestCost (the islands report their new best solutions concurrently)
+		double bestCost;								// Best cost reported so far
+		Job() : isStopRequested(false), isCancelled(false), bestCost(1.e30) {}
+	};
+
+	// Channel of requests and responses: the standard input and output, or a connection to the socket
+	struct Session
+	{
+		int inputFd;									// File descriptor from which the requests are read
+		int outputFd;									// File descriptor to which the responses are written
+		std::mutex outputMutex;							// Serializes the responses, one line at a time
+		std::mutex jobsMutex;							// Protects the jobs
+		std::condition_variable jobsDone;				// Signals the end of a job
+		std::map < std::string, std::shared_ptr <Job> > jobs;	// Jobs of the session not finished yet, by identifier
+		Session(int inputFd, int outputFd) : inputFd(inputFd), outputFd(outputFd) {}
+	};
+
+	AlgorithmParameters defaultAp;						// Parameters of the line of command, used for the parameters missing from a request
+	int defaultNbVehicles;								// Number of vehicles of the line of command
+	bool defaultIsRoundingInteger;						// Rounding convention of the line of command
+	int cacheSize;										// Maximum number of idle solvers kept between the requests
+	WorkStealingPool pool;								// Worker threads solving the requests
+	std::mutex cacheMutex;								// Protects idleSolvers
+	std::list < std::pair < std::string, std::unique_ptr <Solver> > > idleSolvers;	// Idle solvers with their cache keys, the most recently used first
+	std::atomic <bool> isShutdownRequested;				// Tells the sessions to stop reading requests
+	std::mutex sessionsMutex;							// Protects sessions
+	std::list < std::shared_ptr <Session> > sessions;	// Open sessions
+	int listenFd;										// Listening socket (-1 when reading the standard input)
+
+	// Writes a response line to a session
+	void respond(Session & session, const std::string & line);
+
+	// Writes an error response for a request
+	void respondError(Session & session, const std::string & id, const std::string & code, const std::string & message);
+
+	// Takes an idle solver with the given key (most recently used first), or creates one
+	std::unique_ptr <Solver> acquireSolver(const std::string & cacheKey, const AlgorithmParameters & ap);
+
+	// Puts a solver back in the cache, and releases the least recently used solvers beyond cacheSize
+	void releaseSolver(const std::string & cacheKey, std::unique_ptr <Solver> solver);
+
+	// Reads a solve request into a job
+	std::shared_ptr <Job> readJob(const JsonValue & request, const std::string & id);
+
+	// Runs a job (task of the worker pool), and writes its solution or error
+	void runJob(std::shared_ptr <Session> session, std::shared_ptr <Job> job);
+
+	// Processes one line of requests
+	void handleRequest(std::shared_ptr <Session> session, const std::string & line);
+
+	// Reads and processes the requests of a session until its end or a shutdown request, then waits for its jobs
+	void runSession(std::shared_ptr <Session> session);
+
+	// Stops reading the requests of all sessions
+	void requestShutdown();
+
+public:
+
+	// Serves the requests of the endpoint: "stdin" for the standard input and output, or the path of a Unix domain socket
+	// In the first case, the standard output is kept for the responses, and anything else written to it (traces of the searches) is sent to the standard error
+	void run(const std::string & endpoint);
+
+	// Constructor: default parameters of the requests, number of worker threads (0 for the number of hardware threads), and number of idle solvers kept
+	Daemon(const AlgorithmParameters & ap, int nbVehicles, bool isRoundingInteger, int nbWorkers, int cacheSize);
+};
+
+#endif
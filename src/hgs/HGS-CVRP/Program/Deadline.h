@@ -0,0 +1,58 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <chrono>
+#include <atomic>
+
+// Time budgets of the algorithm, measured in wall-clock time with a monotonic clock
+// Unlike clock(), which measures the CPU time of the process (summed over all threads), this time does not run faster when several threads are used and includes I/O waits
+class Deadline
+{
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	Clock::time_point startTime;			// Start time of the optimization
+	Clock::time_point endTime;				// End of the overall time budget (if isLimited)
+	Clock::time_point constructionEndTime;	// End of the time budget of the current population construction (if isConstructionLimited)
+	double constructionTimeLimit;			// Time budget of each population construction (initial population and restarts) in seconds, or 0 if not limited
+	bool isLimited;							// Tells if the overall time budget is limited
+	bool isConstructionLimited;				// Tells if the population constructions have their own time budget
+	const std::atomic <bool> * stopRequest = nullptr;	// Flag set by another thread to end the search as soon as possible, as if the time budget was exhausted (NULL if not used)
+
+	// Elapsed wall-clock time since the start, in seconds
+	double getElapsedTime() const { return std::chrono::duration<double>(Clock::now() - startTime).count(); }
+
+	// Tells if the overall time budget is exhausted, or if a stop has been requested
+	bool isOver() const { return (stopRequest != nullptr && stopRequest->load(std::memory_order_relaxed)) || (isLimited && Clock::now() >= endTime); }
+
+	// Tells if the time budget of the current population construction (or the overall time budget) is exhausted
+	bool isConstructionOver() const { return (isConstructionLimited && Clock::now() >= constructionEndTime) || isOver(); }
+
+	// Starts the time budget of a new population construction
+	void startConstruction()
+	{
+		if (isConstructionLimited) constructionEndTime = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(constructionTimeLimit));
+	}
+
+	// Moves the start time backward, such that elapsedTime seconds have already been spent (used to resume an interrupted search)
+	void shift(double elapsedTime)
+	{
+		Clock::duration shift = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(elapsedTime));
+		startTime -= shift;
+		endTime -= shift;
+	}
+
+	// Starts the clock, with the given time budgets in seconds (0 = not limited)
+	void start(double timeLimit, double constructionTimeLimit)
+	{
+		startTime = Clock::now();
+		isLimited = (timeLimit > 0);
+		endTime = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeLimit));
+		this->constructionTimeLimit = constructionTimeLimit;
+		isConstructionLimited = (constructionTimeLimit > 0);
+		constructionEndTime = endTime;
+	}
+};
+
+#endif
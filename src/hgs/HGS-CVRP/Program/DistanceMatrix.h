@@ -0,0 +1,83 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// Square distance matrix in row-major order, accessed as matrix[i][j]
+// The values are either owned (one contiguous allocation), or borrowed from a buffer of the caller without any copy
+// A borrowed buffer is never written: the first modification (set) copies it into owned memory
+class DistanceMatrix
+{
+private:
+
+	std::vector <double> ownedValues;	// Values when the matrix is owned (empty when borrowed)
+	const double * values;				// First value of the matrix (owned or borrowed)
+	int size;							// Number of rows and columns
+	int stride;							// Number of values between the starts of two consecutive rows
+
+public:
+
+	// Row i of the matrix
+	const double * operator[](int i) const { return values + (std::size_t)i * stride; }
+
+	// Number of rows and columns
+	int getSize() const { return size; }
+
+	// Tells if the values are borrowed from the caller
+	bool isBorrowed() const { return size > 0 && values != ownedValues.data(); }
+
+	// Makes the matrix an owned n x n matrix, reusing the memory of the previous owned matrix (the values are not initialized)
+	void resize(int n)
+	{
+		ownedValues.resize((std::size_t)n * n);
+		values = ownedValues.data();
+		size = n;
+		stride = n;
+	}
+
+	// Borrows the n x n matrix of a caller, whose row i starts at buffer + i * stride
+	// The buffer should remain valid and unchanged as long as it is used by the matrix
+	void borrow(const double * buffer, int n, int stride)
+	{
+		values = buffer;
+		size = n;
+		this->stride = stride;
+	}
+
+	// Sets the value of an element, after copying the matrix into owned memory if it is borrowed
+	void set(int i, int j, double value)
+	{
+		if (isBorrowed())
+		{
+			std::vector <double> copy((std::size_t)size * size);
+			for (int k = 0; k < size; k++)
+				std::copy((*this)[k], (*this)[k] + size, copy.begin() + (std::size_t)k * size);
+			ownedValues.swap(copy);
+			values = ownedValues.data();
+			stride = size;
+		}
+		ownedValues[(std::size_t)i * stride + j] = value;
+	}
+
+	// Copies: an owned matrix is copied, and a borrowed matrix remains borrowed
+	DistanceMatrix(const DistanceMatrix & other) : ownedValues(other.ownedValues), values(other.values), size(other.size), stride(other.stride)
+	{
+		if (!other.isBorrowed()) values = ownedValues.data();
+	}
+
+	DistanceMatrix & operator=(const DistanceMatrix & other)
+	{
+		ownedValues = other.ownedValues;
+		values = other.isBorrowed() ? other.values : ownedValues.data();
+		size = other.size;
+		stride = other.stride;
+		return *this;
+	}
+
+	// Empty matrix
+	DistanceMatrix() : values(nullptr), size(0), stride(0) {}
+};
+
+#endif
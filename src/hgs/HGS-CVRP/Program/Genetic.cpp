@@ -1,20 +1,51 @@
 #include "Genetic.h"
+#include "IslandModel.h"
+#include "Checkpoint.h"
+#include "AllocationCounter.h"
 
 void Genetic::run()
 {	
-	/* INITIAL POPULATION */
-	population.generatePopulation();
-
-	int nbIter;
+	/* INITIAL POPULATION (OR STATE OF AN INTERRUPTED SEARCH) */
+	int nbIter = 0;
 	int nbIterNonProd = 1;
+	if (!pathResume.empty())
+	{
+		// The clock is shifted by the time spent before the interruption, also in the copies of the parameters held by the workers
+		population.readSnapshot(pathResume, nbIter, nbIterNonProd);
+		for (std::unique_ptr <Worker> & worker : workers) worker->params.deadline = params.deadline;
+	}
+	if (params.ap.gap > 0 && lowerBound == NULL)
+	{
+		// The lower bound is computed by a background thread, in parallel with the search (starting with the construction of the population)
+		// It is created after reading a snapshot, such that its copy of the clock includes the time spent before the interruption
+		ownLowerBound.reset(new LowerBound(params));
+		lowerBound = ownLowerBound.get();
+	}
+	if (pathResume.empty()) population.generatePopulation();
+
+	/* SHARED POPULATION MODE */
+	if (threadPool)
+	{
+		runSharedPopulation(nbIter, nbIterNonProd);
+		finishLowerBound();
+		return;
+	}
+
 	if (params.verbose) std::cout << "----- STARTING GENETIC ALGORITHM" << std::endl;
-	for (nbIter = 0 ; nbIterNonProd <= params.ap.nbIter && (params.ap.timeLimit == 0 || (double)(clock()-params.startTime)/(double)CLOCKS_PER_SEC < params.ap.timeLimit) ; nbIter++)
+	int nbIterRun = 0;
+	long long nbAllocationsStart = -1;
+	for ( ; nbIterNonProd <= params.ap.nbIter && !params.deadline.isOver() ; nbIter++, nbIterRun++)
 	{	
+		/* HEAP ALLOCATIONS AFTER THE WARM-UP ITERATIONS (ONLY COUNTED IN THE TEST BUILDS) */
+		if (nbIterRun == nbIterWarmUp) nbAllocationsStart = getNbHeapAllocations();
+
 		/* SELECTION AND CROSSOVER */
-		crossoverOX(offspring, population.getBinaryTournament(),population.getBinaryTournament());
+		crossover.run(offspring, population.getBinaryTournament(),population.getBinaryTournament());
 
 		/* LOCAL SEARCH */
 		localSearch.run(offspring, params.penaltyCapacity, params.penaltyDuration);
+		nbOffspring++;
+		nbMovesOffspring += localSearch.nbMovesLastRun;
 		bool isNewBest = population.addIndividual(offspring,true);
 		if (!offspring.eval.isFeasible && params.ran()%2 == 0) // Repair half of the solutions in case of infeasibility
 		{
@@ -26,61 +57,192 @@ void Genetic::run()
 		if (isNewBest) nbIterNonProd = 1;
 		else nbIterNonProd ++ ;
 
+		/* EARLY TERMINATION ONCE THE BEST SOLUTION IS WITHIN THE REQUESTED GAP OF THE LOWER BOUND */
+		if (lowerBound != NULL && population.getBestFound() != NULL && lowerBound->isGapReached(population.getBestFound()->eval.penalizedCost)) { nbIter++; break; }
+
 		/* DIVERSIFICATION, PENALTY MANAGEMENT AND TRACES */
 		if (nbIter % params.ap.nbIterPenaltyManagement == 0) population.managePenalties();
 		if (nbIter % params.ap.nbIterTraces == 0) population.printState(nbIter, nbIterNonProd);
 
+		/* MIGRATION OF ELITE INDIVIDUALS BETWEEN ISLANDS (PARALLEL ISLAND MODEL) */
+		if (islandModel != NULL && nbIter > 0 && nbIter % params.ap.migrationInterval == 0 && islandModel->migrate(islandIndex)) nbIterNonProd = 1;
+
 		/* FOR TESTS INVOLVING SUCCESSIVE RUNS UNTIL A TIME LIMIT: WE RESET THE ALGORITHM/POPULATION EACH TIME maxIterNonProd IS ATTAINED*/
 		if (params.ap.timeLimit != 0 && nbIterNonProd == params.ap.nbIter)
 		{
 			population.restart();
 			nbIterNonProd = 1;
 		}
+
+		/* SNAPSHOT OF THE SEARCH STATE, AND INTERRUPTION IF REQUESTED BY A SIGNAL */
+		if (checkpoint != NULL && checkpoint->isDue())
+		{
+			checkpoint->save(population, nbIter + 1, nbIterNonProd);
+			if (checkpoint->isStopRequested()) { nbIter++; break; }
+		}
 	}
-	if (params.verbose) std::cout << "----- GENETIC ALGORITHM FINISHED AFTER " << nbIter << " ITERATIONS. TIME SPENT: " << (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC << std::endl;
+	if (nbAllocationsStart >= 0) nbAllocationsSteadyState = getNbHeapAllocations() - nbAllocationsStart;
+	if (params.verbose) std::cout << "----- GENETIC ALGORITHM FINISHED AFTER " << nbIter << " ITERATIONS. TIME SPENT: " << params.deadline.getElapsedTime() << std::endl;
+	if (params.verbose && nbOffspring > 0) std::cout << "----- AVERAGE NUMBER OF LOCAL SEARCH MOVES PER OFFSPRING: " << (double)nbMovesOffspring / (double)nbOffspring << std::endl;
+	if (params.verbose && params.ap.adaptiveMoveOrder == 1 && params.ap.deterministic == 0) localSearch.printMoveStatistics();
+	finishLowerBound();
 }
 
-void Genetic::crossoverOX(Individual & result, const Individual & parent1, const Individual & parent2)
+void Genetic::finishLowerBound()
 {
-	// Frequency table to track the customers which have been already inserted
-	std::vector <bool> freqClient = std::vector <bool> (params.nbClients + 1, false);
-
-	// Picking the beginning and end of the crossover zone
-	std::uniform_int_distribution<> distr(0, params.nbClients-1);
-	int start = distr(params.ran);
-	int end = distr(params.ran);
-
-	// Avoid that start and end coincide by accident
-	while (end == start) end = distr(params.ran);
-
-	// Copy from start to end
-	int j = start;
-	while (j % params.nbClients != (end + 1) % params.nbClients)
+	if (!ownLowerBound) return;
+	if (params.verbose)
 	{
-		result.chromT[j % params.nbClients] = parent1.chromT[j % params.nbClients];
-		freqClient[result.chromT[j % params.nbClients]] = true;
-		j++;
+		const Individual * best = population.getBestFound();
+		std::printf("----- LOWER BOUND: %.2f (%d SUBGRADIENT ITERATIONS)", ownLowerBound->getBound(), ownLowerBound->getNbIterations());
+		if (best != NULL && ownLowerBound->getBound() > 0.) std::printf(" | GAP OF THE BEST SOLUTION: %.2f%%", 100. * (best->eval.penalizedCost - ownLowerBound->getBound()) / ownLowerBound->getBound());
+		std::printf("\n");
 	}
+	ownLowerBound.reset();
+	lowerBound = NULL;
+}
 
-	// Fill the remaining elements in the order given by the second parent
-	for (int i = 1; i <= params.nbClients; i++)
+// Tells if the range of iterations [start, start+size) contains a multiple of period
+static bool containsMultiple(int start, int size, int period)
+{
+	return (start + size - 1) / period * period >= start;
+}
+
+void Genetic::runSharedPopulation(int nbIter, int nbIterNonProd)
+{
+	int batchSize = (int)offspringBatch.size();
+	if (params.verbose) std::cout << "----- STARTING GENETIC ALGORITHM WITH A SHARED POPULATION AND " << threadPool->size() << " THREADS" << std::endl;
+	for ( ; nbIterNonProd <= params.ap.nbIter && !params.deadline.isOver() ; nbIter += batchSize)
 	{
-		int temp = parent2.chromT[(end + i) % params.nbClients];
-		if (freqClient[temp] == false)
+		/* SELECTION OF ALL THE PARENTS OF THE BATCH */
+		for (int i = 0; i < 2 * batchSize; i++) parentsBatch[i] = &population.getBinaryTournament();
+		for (std::unique_ptr <Worker> & worker : workers)
+		{
+			worker->params.penaltyCapacity = params.penaltyCapacity;
+			worker->params.penaltyDuration = params.penaltyDuration;
+		}
+
+		/* CROSSOVER, LOCAL SEARCH AND REPAIR IN PARALLEL (THE POPULATION IS NOT MODIFIED DURING THIS PHASE) */
+		auto generateOffspring = [&](int i, Worker & worker)
+		{
+			worker.crossover.run(offspringBatch[i], *parentsBatch[2 * i], *parentsBatch[2 * i + 1]);
+			worker.localSearch.run(offspringBatch[i], worker.params.penaltyCapacity, worker.params.penaltyDuration);
+			nbMovesBatch[i] = worker.localSearch.nbMovesLastRun;
+			isRepairedBatch[i] = false;
+			if (!offspringBatch[i].eval.isFeasible && worker.params.ran() % 2 == 0) // Repair half of the solutions in case of infeasibility
+			{
+				repairedBatch[i].copySolution(offspringBatch[i]);
+				worker.localSearch.run(repairedBatch[i], worker.params.penaltyCapacity*10., worker.params.penaltyDuration*10.);
+				isRepairedBatch[i] = repairedBatch[i].eval.isFeasible;
+			}
+		};
+		if (params.ap.deterministic)
 		{
-			result.chromT[j % params.nbClients] = temp;
-			j++;
+			// Offspring i = w, w+nbWorkers, ... are generated by worker w, such that the state of each worker (random number generator and shuffled neighborhoods) does not depend on the scheduling of the threads
+			int nbWorkers = (int)workers.size();
+			threadPool->parallelFor(nbWorkers, [&](int w, int)
+			{
+				for (int i = w; i < batchSize; i += nbWorkers) generateOffspring(i, *workers[w]);
+			});
+		}
+		else threadPool->parallelFor(batchSize, [&](int i, int thread) { generateOffspring(i, *workers[thread]); });
+
+		/* INSERTION OF THE OFFSPRING IN THE ORDER OF THE BATCH, AND TRACKING OF THE ITERATIONS SINCE LAST SOLUTION IMPROVEMENT */
+		for (int i = 0; i < batchSize; i++)
+		{
+			bool isNewBest = population.addIndividual(offspringBatch[i], true);
+			nbOffspring++;
+			nbMovesOffspring += nbMovesBatch[i];
+			if (isRepairedBatch[i]) isNewBest = (population.addIndividual(repairedBatch[i], false) || isNewBest);
+			if (isNewBest) nbIterNonProd = 1;
+			else nbIterNonProd ++ ;
+		}
+
+		/* EARLY TERMINATION ONCE THE BEST SOLUTION IS WITHIN THE REQUESTED GAP OF THE LOWER BOUND */
+		if (lowerBound != NULL && population.getBestFound() != NULL && lowerBound->isGapReached(population.getBestFound()->eval.penalizedCost)) { nbIter += batchSize; break; }
+
+		/* DIVERSIFICATION, PENALTY MANAGEMENT AND TRACES (AT THE BATCH BOUNDARY) */
+		if (containsMultiple(nbIter, batchSize, params.ap.nbIterPenaltyManagement)) population.managePenalties();
+		if (containsMultiple(nbIter, batchSize, params.ap.nbIterTraces)) population.printState(nbIter + batchSize - 1, nbIterNonProd);
+
+		/* FOR TESTS INVOLVING SUCCESSIVE RUNS UNTIL A TIME LIMIT: WE RESET THE ALGORITHM/POPULATION EACH TIME maxIterNonProd IS ATTAINED*/
+		if (params.ap.timeLimit != 0 && nbIterNonProd >= params.ap.nbIter)
+		{
+			population.restart();
+			nbIterNonProd = 1;
+		}
+
+		/* SNAPSHOT OF THE SEARCH STATE, AND INTERRUPTION IF REQUESTED BY A SIGNAL */
+		if (checkpoint != NULL && checkpoint->isDue())
+		{
+			checkpoint->save(population, nbIter + batchSize, nbIterNonProd);
+			if (checkpoint->isStopRequested()) { nbIter += batchSize; break; }
 		}
 	}
+	if (params.verbose) std::cout << "----- GENETIC ALGORITHM FINISHED AFTER " << nbIter << " ITERATIONS. TIME SPENT: " << params.deadline.getElapsedTime() << std::endl;
+	if (params.verbose && nbOffspring > 0) std::cout << "----- AVERAGE NUMBER OF LOCAL SEARCH MOVES PER OFFSPRING: " << (double)nbMovesOffspring / (double)nbOffspring << std::endl;
+}
+
+long long Genetic::getNbLocalSearches() const
+{
+	long long nbLocalSearches = localSearch.nbRuns;
+	for (const std::unique_ptr <Worker> & worker : workers) nbLocalSearches += worker->localSearch.nbRuns;
+	return nbLocalSearches;
+}
 
-	// Complete the individual with the Split algorithm
-	split.generalSplit(result, parent1.eval.nbRoutes);
+void Genetic::reset()
+{
+	population.reset();
+	pathResume.clear();
+	nbOffspring = 0;
+	nbMovesOffspring = 0;
+	nbAllocationsSteadyState = -1;
+	localSearch.nbRuns = 0;
+	for (int w = 0; w < (int)workers.size(); w++)
+	{
+		// The workers are restored in the state of their construction, with the data of the new instance and the clock of the new search
+		std::seed_seq seedSequence{ params.ap.seed, w };
+		workers[w]->params.copyInstance(params);
+		workers[w]->params.deadline = params.deadline;
+		workers[w]->params.ran.seed(seedSequence);
+		workers[w]->localSearch.nbRuns = 0;
+	}
 }
 
 Genetic::Genetic(Params & params) : 
 	params(params), 
 	split(params),
 	localSearch(params),
+	reoptimization(params,this->localSearch),
+	crossover(params,this->split,this->reoptimization),
 	population(params,this->split,this->localSearch),
-	offspring(params){}
+	offspring(params),
+	islandModel(NULL),
+	islandIndex(0),
+	checkpoint(NULL),
+	lowerBound(NULL),
+	nbOffspring(0),
+	nbMovesOffspring(0),
+	nbIterWarmUp(1000),
+	nbAllocationsSteadyState(-1)
+{
+	if (params.ap.nbThreads > 1 && params.ap.parallelScheme == 1)
+	{
+		threadPool.reset(new ThreadPool(params.ap.nbThreads));
+		for (int i = 0; i < params.ap.nbThreads; i++)
+			workers.emplace_back(new Worker(params, i));
+
+		// Several offspring per thread in each batch, such that differences of local search durations are balanced between the threads
+		int batchSize = 4 * params.ap.nbThreads;
+		parentsBatch = std::vector < const Individual * >(2 * batchSize, NULL);
+		offspringBatch = std::vector < Individual >(batchSize, Individual(params, false));
+		repairedBatch = std::vector < Individual >(batchSize, Individual(params, false));
+		isRepairedBatch = std::vector < char >(batchSize, false);
+		nbMovesBatch = std::vector < int >(batchSize, 0);
+
+		// The initial population (and the population after each restart) is also built in parallel
+		population.threadPool = threadPool.get();
+		population.workers = &workers;
+	}
+}
 
@@ -25,6 +25,14 @@ SOFTWARE.*/
 
 #include "Population.h"
 #include "Individual.h"
+#include "ThreadPool.h"
+#include "Worker.h"
+#include "Crossover.h"
+#include "LowerBound.h"
+#include <memory>
+
+class IslandModel;
+class Checkpoint;
 
 class Genetic
 {
@@ -33,15 +41,45 @@ public:
 	Params & params;				// Problem parameters
 	Split split;					// Split algorithm
 	LocalSearch localSearch;		// Local Search structure
+	Reoptimization reoptimization;	// Cheapest insertions used by the route-based crossover
+	Crossover crossover;			// Crossover operators
 	Population population;			// Population (public for now to give access to the solutions, but should be be improved later on)
 	Individual offspring;			// First individual to be used as input for the crossover
+	IslandModel * islandModel;		// Island model to which this run belongs (NULL for a sequential run)
+	int islandIndex;				// Index of this run in the island model
+	Checkpoint * checkpoint;		// Periodic snapshots of the population (NULL if not requested)
+	LowerBound * lowerBound;		// Lower bound used for the early termination on ap.gap (NULL if inactive, shared by the islands in the island model)
+	std::unique_ptr <LowerBound> ownLowerBound;	// Lower bound computed by this run, when it does not belong to an island model
+	std::string pathResume;			// Snapshot from which the search is resumed (empty for a new search)
+	long long nbOffspring;			// Number of offspring generated by crossover (statistics)
+	long long nbMovesOffspring;		// Total number of moves applied by the local search to these offspring, before any repair (statistics)
+	int nbIterWarmUp;				// Number of iterations after which the heap allocations of the main loop are counted
+	long long nbAllocationsSteadyState;	// Heap allocations of the sequential main loop after the warm-up iterations (-1 if not counted, see AllocationCounter.h)
 
-	// OX Crossover
-	void crossoverOX(Individual & result, const Individual & parent1, const Individual & parent2);
+	/* SHARED POPULATION MODE: OFFSPRING GENERATED IN PARALLEL BY SEVERAL WORKERS */
+	std::unique_ptr <ThreadPool> threadPool;				// Threads running the workers (NULL in the other modes)
+	std::vector < std::unique_ptr <Worker> > workers;		// Split and local search structures of each thread
+	std::vector < const Individual * > parentsBatch;		// Parents selected for the current batch of offspring
+	std::vector < Individual > offspringBatch;				// Offspring of the current batch, after local search
+	std::vector < Individual > repairedBatch;				// Repaired offspring of the current batch
+	std::vector < char > isRepairedBatch;					// Tells whether the offspring has been successfully repaired
+	std::vector < int > nbMovesBatch;						// Number of local search moves applied to each offspring of the current batch
 
     // Running the genetic algorithm until maxIterNonProd consecutive iterations or a time limit
     void run() ;
 
+	// Main loop of the shared population mode: batches of offspring are generated in parallel, and inserted in the population in a fixed order by the calling thread
+	void runSharedPopulation(int nbIter, int nbIterNonProd);
+
+	// Displays the lower bound and the gap of the best solution, and stops the computation of the bound if it belongs to this run
+	void finishLowerBound();
+
+	// Number of local searches run since the construction or the last reset, by all threads (statistics)
+	long long getNbLocalSearches() const;
+
+	// Prepares a new run on the current data of params (same numbers of clients and vehicles), keeping the memory of all search structures
+	void reset();
+
 	// Constructor
 	Genetic(Params & params);
 };
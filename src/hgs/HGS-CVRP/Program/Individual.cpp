@@ -3,24 +3,28 @@
 void Individual::evaluateCompleteCost(const Params & params)
 {
 	eval = EvalIndiv();
+	hash = 0;
 	for (int r = 0; r < params.nbVehicles; r++)
 	{
-		if (!chromR[r].empty())
+		if (routeLength[r] > 0)
 		{
-			double distance = params.timeCost[0][chromR[r][0]];
-			double load = params.cli[chromR[r][0]].demand;
-			double service = params.cli[chromR[r][0]].serviceDuration;
-			predecessors[chromR[r][0]] = 0;
-			for (int i = 1; i < (int)chromR[r].size(); i++)
+			const int * myRoute = route(r);
+			double distance = params.timeCost[0][myRoute[0]];
+			double load = params.cli[myRoute[0]].demand;
+			double service = params.cli[myRoute[0]].serviceDuration;
+			predecessors[myRoute[0]] = 0;
+			for (int i = 1; i < routeLength[r]; i++)
 			{
-				distance += params.timeCost[chromR[r][i-1]][chromR[r][i]];
-				load += params.cli[chromR[r][i]].demand;
-				service += params.cli[chromR[r][i]].serviceDuration;
-				predecessors[chromR[r][i]] = chromR[r][i-1];
-				successors[chromR[r][i-1]] = chromR[r][i];
+				distance += params.timeCost[myRoute[i-1]][myRoute[i]];
+				load += params.cli[myRoute[i]].demand;
+				service += params.cli[myRoute[i]].serviceDuration;
+				predecessors[myRoute[i]] = myRoute[i-1];
+				successors[myRoute[i-1]] = myRoute[i];
+				hash += edgeHash(myRoute[i-1], myRoute[i]);
 			}
-			successors[chromR[r][chromR[r].size()-1]] = 0;
-			distance += params.timeCost[chromR[r][chromR[r].size()-1]][0];
+			successors[myRoute[routeLength[r]-1]] = 0;
+			distance += params.timeCost[myRoute[routeLength[r]-1]][0];
+			hash += edgeHash(0, myRoute[0]) + edgeHash(myRoute[routeLength[r]-1], 0);
 			eval.distance += distance;
 			eval.nbRoutes++;
 			if (load > params.vehicleCapacity) eval.capacityExcess += load - params.vehicleCapacity;
@@ -32,14 +36,47 @@ void Individual::evaluateCompleteCost(const Params & params)
 	eval.isFeasible = (eval.capacityExcess < MY_EPSILON && eval.durationExcess < MY_EPSILON);
 }
 
-Individual::Individual(Params & params)
+void Individual::copySolution(const Individual & indiv)
+{
+	eval = indiv.eval;
+	chromT = indiv.chromT;
+	routeOffset = indiv.routeOffset;
+	routeLength = indiv.routeLength;
+	successors = indiv.successors;
+	predecessors = indiv.predecessors;
+	biasedFitness = indiv.biasedFitness;
+	hash = indiv.hash;
+	indivsPerProximity.clear();
+}
+
+void Individual::sweepTour(Params & params)
+{
+	int startAngle = params.ran() % 65536;
+	int jitter = std::max<int>(1, 2 * 65536 / params.nbClients);
+	bool isClockwise = (params.ran() % 2 == 0);
+	std::vector < std::pair <int, int> > angles(params.nbClients);
+	for (int i = 1; i <= params.nbClients; i++)
+	{
+		int angle = CircleSector::positive_mod(params.cli[i].polarAngle - startAngle + (int)(params.ran() % (2 * jitter + 1)) - jitter);
+		angles[i - 1] = { isClockwise ? 65535 - angle : angle, i };
+	}
+	std::sort(angles.begin(), angles.end());
+	for (int i = 0; i < params.nbClients; i++) chromT[i] = angles[i].second;
+}
+
+Individual::Individual(Params & params, bool initializeChromTAndShuffle)
 {
 	successors = std::vector <int>(params.nbClients + 1);
 	predecessors = std::vector <int>(params.nbClients + 1);
-	chromR = std::vector < std::vector <int> >(params.nbVehicles);
+	routeOffset = std::vector <int>(params.nbVehicles, 0);
+	routeLength = std::vector <int>(params.nbVehicles, 0);
 	chromT = std::vector <int>(params.nbClients);
-	for (int i = 0; i < params.nbClients; i++) chromT[i] = i + 1;
-	std::shuffle(chromT.begin(), chromT.end(), params.ran);
+	hash = 0;
+	if (initializeChromTAndShuffle)
+	{
+		for (int i = 0; i < params.nbClients; i++) chromT[i] = i + 1;
+		std::shuffle(chromT.begin(), chromT.end(), params.ran);
+	}
 	eval.penalizedCost = 1.e30;	
 }
 
@@ -53,19 +90,25 @@ Individual::Individual(Params & params, std::string fileName) : Individual(param
 		std::string inputString;
 		inputFile >> inputString;
 		// Loops in the input file as long as the first line keyword is "Route"
-		for (int r = 0; inputString == "Route"; r++)
+		int r = 0;
+		for (; inputString == "Route"; r++)
 		{
+			if (r >= params.nbVehicles) throw std::string("Input solution contains more routes than available vehicles");
 			inputFile >> inputString;
 			getline(inputFile, inputString);
 			std::stringstream ss(inputString);
 			int inputCustomer;
+			routeOffset[r] = (int)chromT.size();
 			while (ss >> inputCustomer) // Loops as long as there is an integer to read in this route
-			{
 				chromT.push_back(inputCustomer);
-				chromR[r].push_back(inputCustomer);
-			}
+			routeLength[r] = (int)chromT.size() - routeOffset[r];
 			inputFile >> inputString;
 		}
+		for (; r < params.nbVehicles; r++)
+		{
+			routeOffset[r] = (int)chromT.size();
+			routeLength[r] = 0;
+		}
 		if (inputString == "Cost") inputFile >> readCost;
 		else throw std::string("Unexpected token in input solution");
 
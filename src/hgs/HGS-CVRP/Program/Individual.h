@@ -24,6 +24,7 @@ SOFTWARE.*/
 #define INDIVIDUAL_H
 
 #include "Params.h"
+#include <cstdint>
 
 struct EvalIndiv
 {
@@ -40,18 +41,44 @@ class Individual
 public:
 
   EvalIndiv eval;															// Solution cost parameters
-  std::vector < int > chromT ;												// Giant tour representing the individual
-  std::vector < std::vector <int> > chromR ;								// For each vehicle, the associated sequence of deliveries (complete solution)
+  std::vector < int > chromT ;												// Giant tour representing the individual. In a complete solution, the routes are stored one after the other in this array
+  std::vector < int > routeOffset ;											// For each vehicle, position in chromT of the first delivery of its route (complete solution)
+  std::vector < int > routeLength ;											// For each vehicle, number of deliveries in its route (complete solution)
   std::vector < int > successors ;											// For each node, the successor in the solution (can be the depot 0)
   std::vector < int > predecessors ;										// For each node, the predecessor in the solution (can be the depot 0)
-  std::multiset < std::pair < double, Individual* > > indivsPerProximity ;	// The other individuals in the population, ordered by increasing proximity (the set container follows a natural ordering based on the first value of the pair)
+  std::vector < std::pair < double, Individual* > > indivsPerProximity ;	// The other individuals in the population, ordered by increasing proximity (kept sorted, its capacity is reserved once by the population)
   double biasedFitness;														// Biased fitness of the solution
+  uint64_t hash;															// Hash of the set of (undirected) edges of the solution. Two solutions with the same edges have the same hash, used to detect clones without a distance computation
 
-  // Measuring cost and feasibility of an Individual from the information of chromR (needs chromR filled and access to Params)
+  // Since all the containers above are flat arrays of fixed size, copying an individual into another one of the same instance reduces to a few memcpy and does not allocate memory
+
+  // Copies the solution of another individual, without its proximity structure (which is specific to the population containing it)
+  void copySolution(const Individual & indiv);
+
+  // Accesses the deliveries of route r (routeLength[r] elements)
+  inline const int * route(int r) const { return chromT.data() + routeOffset[r]; }
+
+  // Measuring cost and feasibility of an Individual from the information of the routes (needs routeOffset and routeLength filled and access to Params)
+  // Also fills the successors, predecessors and hash of the solution
   void evaluateCompleteCost(const Params & params);
 
+  // Hash of an undirected edge {i,j}. The hash of a solution is the sum of the hashes of its edges (a sum rather than a XOR, such that single-customer routes using the same depot edge twice do not cancel out)
+  static inline uint64_t edgeHash(int i, int j)
+  {
+	  // splitmix64 finalizer applied on the ordered pair
+	  uint64_t z = ((uint64_t)std::min<int>(i, j) << 32 | (uint64_t)std::max<int>(i, j)) + 0x9e3779b97f4a7c15ULL;
+	  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	  return z ^ (z >> 31);
+  }
+
+  // Replaces the giant tour by a sweep of the clients around the depot, by increasing polar angle from a random start angle and in a random direction
+  // The polar angles are perturbed by a random jitter of up to twice the average angular gap between two clients, such that successive sweeps differ
+  void sweepTour(Params & params);
+
   // Constructor of a random individual containing only a giant tour with a shuffled visit order
-  Individual(Params & params);
+  // If initializeChromTAndShuffle is false, the memory is only allocated (no random number is drawn), which is used to preallocate individuals
+  Individual(Params & params, bool initializeChromTAndShuffle = true);
 
   // Constructor of an individual from a file in CVRPLib solution format as produced by the algorithm (useful if a user wishes to input an initial solution)
   Individual(Params & params, std::string fileName);
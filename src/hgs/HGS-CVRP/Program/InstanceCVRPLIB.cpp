@@ -59,17 +59,18 @@ InstanceCVRPLIB::InstanceCVRPLIB(std::string pathToInstance, bool isRoundingInte
 		}
 
 		// Calculating 2D Euclidean Distance
-		dist_mtx = std::vector < std::vector< double > >(nbClients + 1, std::vector <double>(nbClients + 1));
+		dist_mtx.resize(nbClients + 1);
 		for (int i = 0; i <= nbClients; i++)
 		{
 			for (int j = 0; j <= nbClients; j++)
 			{
-				dist_mtx[i][j] = std::sqrt(
+				double distance = std::sqrt(
 					(x_coords[i] - x_coords[j]) * (x_coords[i] - x_coords[j])
 					+ (y_coords[i] - y_coords[j]) * (y_coords[i] - y_coords[j])
 				);
 
-				if (isRoundingInteger) dist_mtx[i][j] = round(dist_mtx[i][j]);
+				if (isRoundingInteger) distance = round(distance);
+				dist_mtx.set(i, j, distance);
 			}
 		}
 
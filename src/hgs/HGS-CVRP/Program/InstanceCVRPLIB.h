@@ -6,13 +6,14 @@
 #define INSTANCECVRPLIB_H
 #include<string>
 #include<vector>
+#include "DistanceMatrix.h"
 
 class InstanceCVRPLIB
 {
 public:
 	std::vector<double> x_coords;
 	std::vector<double> y_coords;
-	std::vector< std::vector<double> > dist_mtx;
+	DistanceMatrix dist_mtx;
 	std::vector<double> service_time;
 	std::vector<double> demands;
 	double durationLimit = 1.e30;							// Route duration limit
@@ -0,0 +1,174 @@
+#include "IslandModel.h"
+#include <thread>
+#include <exception>
+
+void IslandModel::synchronize()
+{
+	std::unique_lock <std::mutex> lock(barrierMutex);
+	long long generation = barrierGeneration;
+	if (++nbWaitingIslands == nbRunningIslands)
+	{
+		nbWaitingIslands = 0;
+		barrierGeneration++;
+		barrierCondition.notify_all();
+	}
+	else barrierCondition.wait(lock, [&] { return barrierGeneration != generation; });
+}
+
+void IslandModel::leaveSynchronization()
+{
+	std::lock_guard <std::mutex> lock(barrierMutex);
+	nbRunningIslands--;
+	if (nbWaitingIslands > 0 && nbWaitingIslands == nbRunningIslands)
+	{
+		nbWaitingIslands = 0;
+		barrierGeneration++;
+		barrierCondition.notify_all();
+	}
+}
+
+bool IslandModel::migrateSynchronized(int island)
+{
+	Genetic & myIsland = *islands[island];
+	int round = nbMigrations[island]++;
+
+	// Publishing the best feasible individual, unless it has already been sent
+	const Individual * best = myIsland.population.getBestFeasible();
+	if (best != NULL && best->hash != lastMigrantHash[island])
+	{
+		if (params.ap.migrationTopology == 1)
+		{
+			std::uniform_int_distribution<> distr(0, params.ap.nbThreads - 2);
+			migrantDestination[island] = distr(myIsland.params.ran);
+			if (migrantDestination[island] >= island) migrantDestination[island]++;
+		}
+		else migrantDestination[island] = (island + 1) % params.ap.nbThreads;
+		migrants[island].copySolution(*best);
+		migrantRound[island] = round;
+		lastMigrantHash[island] = best->hash;
+	}
+	synchronize();
+
+	// Integrating the migrants of this round in the order of the sending islands (the islands which have terminated do not publish anymore)
+	bool isNewBest = false;
+	for (int sender = 0; sender < params.ap.nbThreads; sender++)
+	{
+		if (sender == island || migrantRound[sender] != round || migrantDestination[sender] != island) continue;
+		myIsland.offspring.copySolution(migrants[sender]);
+		myIsland.offspring.evaluateCompleteCost(myIsland.params);
+		isNewBest = (myIsland.population.addIndividual(myIsland.offspring, false) || isNewBest);
+	}
+
+	// The migrants are not overwritten before all islands have integrated them
+	synchronize();
+	return isNewBest;
+}
+
+bool IslandModel::migrate(int island)
+{
+	if (params.ap.deterministic) return migrateSynchronized(island);
+
+	Genetic & myIsland = *islands[island];
+
+	// Sending the best feasible individual, unless it has already been sent
+	const Individual * best = myIsland.population.getBestFeasible();
+	if (best != NULL && best->hash != lastMigrantHash[island])
+	{
+		int destination;
+		if (params.ap.migrationTopology == 1)
+		{
+			std::uniform_int_distribution<> distr(0, params.ap.nbThreads - 2);
+			destination = distr(myIsland.params.ran);
+			if (destination >= island) destination++;
+		}
+		else destination = (island + 1) % params.ap.nbThreads;
+		if (mailboxes[destination]->send(*best)) lastMigrantHash[island] = best->hash;
+	}
+
+	// Integrating the received individuals (the offspring is used as a buffer as it is overwritten at each iteration)
+	bool isNewBest = false;
+	while (mailboxes[island]->receive(myIsland.offspring))
+	{
+		myIsland.offspring.evaluateCompleteCost(myIsland.params); // Penalized cost according to the penalty coefficients of this island
+		isNewBest = (myIsland.population.addIndividual(myIsland.offspring, false) || isNewBest);
+	}
+	return isNewBest;
+}
+
+void IslandModel::run()
+{
+	// A single lower bound, computed in parallel with the islands, stops all of them once one island is within the gap
+	std::unique_ptr <LowerBound> lowerBound;
+	if (params.ap.gap > 0)
+	{
+		lowerBound.reset(new LowerBound(params));
+		for (std::unique_ptr <Genetic> & island : islands) island->lowerBound = lowerBound.get();
+	}
+
+	std::vector <std::thread> threads;
+	std::vector <std::exception_ptr> exceptions(islands.size());
+	for (int i = 0; i < (int)islands.size(); i++)
+	{
+		threads.emplace_back([this, i, &exceptions]()
+		{
+			try { islands[i]->run(); }
+			catch (...) { exceptions[i] = std::current_exception(); }
+			if (params.ap.deterministic) leaveSynchronization();
+		});
+	}
+	for (std::thread & thread : threads) thread.join();
+	for (std::exception_ptr & exception : exceptions)
+		if (exception) std::rethrow_exception(exception);
+
+	if (params.verbose)
+		std::cout << "----- ISLAND MODEL FINISHED. BEST SOLUTION FOUND BY ISLAND " << getBestIslandIndex() << std::endl;
+	if (lowerBound)
+	{
+		const Individual * best = getBestIsland().population.getBestFound();
+		if (params.verbose && best != NULL && lowerBound->getBound() > 0.)
+			std::printf("----- LOWER BOUND: %.2f (%d SUBGRADIENT ITERATIONS) | GAP OF THE BEST SOLUTION: %.2f%%\n", lowerBound->getBound(), lowerBound->getNbIterations(), 100. * (best->eval.penalizedCost - lowerBound->getBound()) / lowerBound->getBound());
+		for (std::unique_ptr <Genetic> & island : islands) island->lowerBound = NULL;
+	}
+}
+
+int IslandModel::getBestIslandIndex()
+{
+	int bestIsland = 0;
+	for (int i = 1; i < (int)islands.size(); i++)
+	{
+		const Individual * best = islands[i]->population.getBestFound();
+		const Individual * currentBest = islands[bestIsland]->population.getBestFound();
+		if (best != NULL && (currentBest == NULL || best->eval.penalizedCost < currentBest->eval.penalizedCost - MY_EPSILON))
+			bestIsland = i;
+	}
+	return bestIsland;
+}
+
+Genetic & IslandModel::getBestIsland()
+{
+	return *islands[getBestIslandIndex()];
+}
+
+IslandModel::IslandModel(Params & params) : params(params)
+{
+	for (int i = 0; i < params.ap.nbThreads; i++)
+	{
+		// Each island has its own copy of the parameters, with a random number generator seeded from (seed, island)
+		islandParams.emplace_back(new Params(params));
+		std::seed_seq seedSequence{ params.ap.seed, i };
+		islandParams[i]->ran.seed(seedSequence);
+		islandParams[i]->verbose = (params.verbose && i == 0); // Only the first island displays its traces
+		islands.emplace_back(new Genetic(*islandParams[i]));
+		islands[i]->islandModel = this;
+		islands[i]->islandIndex = i;
+		mailboxes.emplace_back(new Mailbox(*islandParams[i], 4));
+	}
+	lastMigrantHash = std::vector <uint64_t>(params.ap.nbThreads, 0);
+	migrants = std::vector <Individual>(params.ap.nbThreads, Individual(params, false));
+	migrantDestination = std::vector <int>(params.ap.nbThreads, -1);
+	migrantRound = std::vector <int>(params.ap.nbThreads, -1);
+	nbMigrations = std::vector <int>(params.ap.nbThreads, 0);
+	nbRunningIslands = params.ap.nbThreads;
+	nbWaitingIslands = 0;
+	barrierGeneration = 0;
+}
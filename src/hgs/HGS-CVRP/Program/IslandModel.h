@@ -0,0 +1,62 @@
+#ifndef ISLANDMODEL_H
+#define ISLANDMODEL_H
+
+#include "Genetic.h"
+#include "Mailbox.h"
+#include <mutex>
+#include <condition_variable>
+
+// Parallel island model: ap.nbThreads independent HGS runs (islands) on separate threads
+// Each island owns its Params copy (with its own random number generator), Split, LocalSearch and Population
+// Every ap.migrationInterval iterations, each island sends its best feasible individual to another island (ring or random topology) through a lock-free mailbox
+// In the deterministic mode (ap.deterministic), the migrations are instead synchronized: all running islands exchange their migrants at the same iteration, and integrate them in the order of the sending islands
+class IslandModel
+{
+private:
+
+	/* SYNCHRONIZED MIGRATIONS OF THE DETERMINISTIC MODE */
+	std::vector <Individual> migrants;						// Migrant published by each island in the current migration round
+	std::vector <int> migrantDestination;					// Destination of the migrant published by each island
+	std::vector <int> migrantRound;							// Migration round in which each island has published its migrant (-1 if none)
+	std::vector <int> nbMigrations;							// Number of migration rounds of each island
+	std::mutex barrierMutex;								// Protects the barrier counters
+	std::condition_variable barrierCondition;				// Signals the completion of a barrier
+	int nbRunningIslands;									// Number of islands which have not terminated (taking part in the barriers)
+	int nbWaitingIslands;									// Number of islands waiting at the current barrier
+	long long barrierGeneration;							// Counter of completed barriers
+
+	// Waits until all running islands have reached the barrier
+	void synchronize();
+
+	// Removes a terminated island from the barriers
+	void leaveSynchronization();
+
+	// Migration of the deterministic mode, see migrate
+	bool migrateSynchronized(int island);
+
+public:
+
+	Params & params;										// Problem parameters (shared data and master parameters)
+	std::vector < std::unique_ptr <Params> > islandParams;	// Parameters of each island (own random number generator and penalty coefficients)
+	std::vector < std::unique_ptr <Genetic> > islands;		// HGS runs
+	std::vector < std::unique_ptr <Mailbox> > mailboxes;	// Incoming migrants of each island
+	std::vector < uint64_t > lastMigrantHash;				// Hash of the last individual sent by each island (to avoid sending the same individual again)
+
+	// Sends the best feasible individual of an island and integrates the migrants it has received. Called by the island's thread
+	// Returns TRUE if a received migrant is a new best solution for this island
+	bool migrate(int island);
+
+	// Running all the islands in parallel until they all terminate
+	void run();
+
+	// Index of the island containing the best solution found overall
+	int getBestIslandIndex();
+
+	// Island containing the best solution found overall
+	Genetic & getBestIsland();
+
+	// Constructor
+	IslandModel(Params & params);
+};
+
+#endif
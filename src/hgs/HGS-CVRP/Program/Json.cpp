@@ -0,0 +1,269 @@
+#include "Json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+
+// Recursive descent parser over a document
+class JsonParser
+{
+public:
+
+	const std::string & document;	// Document being parsed
+	size_t position;				// Position of the next character to read
+	int depth;						// Current nesting depth of the arrays and objects
+
+	void error(const std::string & message)
+	{
+		throw std::string("Invalid JSON at character " + std::to_string(position) + ": " + message);
+	}
+
+	void skipSpaces()
+	{
+		while (position < document.size() && (document[position] == ' ' || document[position] == '\t' || document[position] == '\n' || document[position] == '\r')) position++;
+	}
+
+	void expectWord(const char * word)
+	{
+		for (const char * c = word; *c != '\0'; c++, position++)
+			if (position >= document.size() || document[position] != *c) error("unexpected token");
+	}
+
+	unsigned int readHexadecimal()
+	{
+		if (position + 4 > document.size()) error("truncated escape");
+		unsigned int code = 0;
+		for (int k = 0; k < 4; k++)
+		{
+			char c = document[position++];
+			code <<= 4;
+			if (c >= '0' && c <= '9') code += c - '0';
+			else if (c >= 'a' && c <= 'f') code += c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F') code += c - 'A' + 10;
+			else error("invalid escape");
+		}
+		return code;
+	}
+
+	void appendUtf8(std::string & output, unsigned int code)
+	{
+		if (code < 0x80) output += (char)code;
+		else if (code < 0x800) { output += (char)(0xC0 | (code >> 6)); output += (char)(0x80 | (code & 0x3F)); }
+		else if (code < 0x10000) { output += (char)(0xE0 | (code >> 12)); output += (char)(0x80 | ((code >> 6) & 0x3F)); output += (char)(0x80 | (code & 0x3F)); }
+		else { output += (char)(0xF0 | (code >> 18)); output += (char)(0x80 | ((code >> 12) & 0x3F)); output += (char)(0x80 | ((code >> 6) & 0x3F)); output += (char)(0x80 | (code & 0x3F)); }
+	}
+
+	std::string parseString()
+	{
+		std::string output;
+		position++; // Opening quote
+		while (true)
+		{
+			if (position >= document.size()) error("unterminated string");
+			char c = document[position++];
+			if (c == '"') return output;
+			if (c != '\\') { output += c; continue; }
+			if (position >= document.size()) error("unterminated string");
+			c = document[position++];
+			switch (c)
+			{
+			case '"': output += '"'; break;
+			case '\\': output += '\\'; break;
+			case '/': output += '/'; break;
+			case 'b': output += '\b'; break;
+			case 'f': output += '\f'; break;
+			case 'n': output += '\n'; break;
+			case 'r': output += '\r'; break;
+			case 't': output += '\t'; break;
+			case 'u':
+			{
+				unsigned int code = readHexadecimal();
+				if (code >= 0xD800 && code < 0xDC00 && position + 1 < document.size() && document[position] == '\\' && document[position + 1] == 'u')
+				{
+					position += 2;
+					unsigned int low = readHexadecimal();
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				}
+				appendUtf8(output, code);
+				break;
+			}
+			default: error("invalid escape");
+			}
+		}
+	}
+
+	JsonValue parseValue()
+	{
+		skipSpaces();
+		if (position >= document.size()) error("unexpected end");
+		JsonValue value;
+		char c = document[position];
+		if (c == '{' || c == '[')
+		{
+			if (++depth > 64) error("too deeply nested");
+			bool isObject = (c == '{');
+			value.type = isObject ? JsonValue::OBJECT : JsonValue::ARRAY;
+			char closing = isObject ? '}' : ']';
+			position++;
+			skipSpaces();
+			if (position < document.size() && document[position] == closing) { position++; depth--; return value; }
+			while (true)
+			{
+				if (isObject)
+				{
+					skipSpaces();
+					if (position >= document.size() || document[position] != '"') error("expected a member name");
+					std::string name = parseString();
+					skipSpaces();
+					if (position >= document.size() || document[position] != ':') error("expected ':'");
+					position++;
+					value.members.emplace_back(name, parseValue());
+				}
+				else value.elements.push_back(parseValue());
+				skipSpaces();
+				if (position >= document.size()) error("unexpected end");
+				if (document[position] == ',') { position++; continue; }
+				if (document[position] != closing) error("expected ',' or a closing bracket");
+				position++;
+				depth--;
+				return value;
+			}
+		}
+		else if (c == '"') { value.type = JsonValue::STRING; value.text = parseString(); }
+		else if (c == 't') { expectWord("true"); value.type = JsonValue::BOOLEAN; value.boolean = true; }
+		else if (c == 'f') { expectWord("false"); value.type = JsonValue::BOOLEAN; value.boolean = false; }
+		else if (c == 'n') { expectWord("null"); }
+		else
+		{
+			const char * begin = document.c_str() + position;
+			char * end;
+			value.number = std::strtod(begin, &end);
+			if (end == begin || (c != '-' && (c < '0' || c > '9'))) error("unexpected token");
+			value.type = JsonValue::NUMBER;
+			position += end - begin;
+		}
+		return value;
+	}
+
+	JsonParser(const std::string & document) : document(document), position(0), depth(0) {}
+};
+
+const JsonValue * JsonValue::find(const std::string & name) const
+{
+	for (const std::pair <std::string, JsonValue> & member : members)
+		if (member.first == name) return &member.second;
+	return nullptr;
+}
+
+double JsonValue::getNumber() const
+{
+	if (type != NUMBER) throw std::string("A number was expected");
+	return number;
+}
+
+int JsonValue::getInt() const
+{
+	if (type != NUMBER || number != std::floor(number) || number < INT_MIN || number > INT_MAX) throw std::string("An integer was expected");
+	return (int)number;
+}
+
+bool JsonValue::getBoolean() const
+{
+	if (type == NUMBER) return number != 0.;
+	if (type != BOOLEAN) throw std::string("A boolean was expected");
+	return boolean;
+}
+
+const std::string & JsonValue::getString() const
+{
+	if (type != STRING) throw std::string("A string was expected");
+	return text;
+}
+
+const std::vector <JsonValue> & JsonValue::getArray() const
+{
+	if (type != ARRAY) throw std::string("An array was expected");
+	return elements;
+}
+
+std::vector <double> JsonValue::getNumbers() const
+{
+	std::vector <double> numbers;
+	numbers.reserve(getArray().size());
+	for (const JsonValue & element : elements) numbers.push_back(element.getNumber());
+	return numbers;
+}
+
+std::string JsonValue::serialize() const
+{
+	std::string output;
+	switch (type)
+	{
+	case NUL: output = "null"; break;
+	case BOOLEAN: output = boolean ? "true" : "false"; break;
+	case NUMBER: appendNumber(output, number); break;
+	case STRING: appendString(output, text); break;
+	case ARRAY:
+		output += '[';
+		for (size_t k = 0; k < elements.size(); k++) output += (k ? "," : "") + elements[k].serialize();
+		output += ']';
+		break;
+	case OBJECT:
+		output += '{';
+		for (size_t k = 0; k < members.size(); k++)
+		{
+			if (k) output += ',';
+			appendString(output, members[k].first);
+			output += ':' + members[k].second.serialize();
+		}
+		output += '}';
+		break;
+	}
+	return output;
+}
+
+JsonValue JsonValue::parse(const std::string & document)
+{
+	JsonParser parser(document);
+	JsonValue value = parser.parseValue();
+	parser.skipSpaces();
+	if (parser.position != document.size()) parser.error("unexpected characters after the value");
+	return value;
+}
+
+void JsonValue::appendString(std::string & output, const std::string & value)
+{
+	output += '"';
+	for (char c : value)
+	{
+		switch (c)
+		{
+		case '"': output += "\\\""; break;
+		case '\\': output += "\\\\"; break;
+		case '\n': output += "\\n"; break;
+		case '\r': output += "\\r"; break;
+		case '\t': output += "\\t"; break;
+		default:
+			if ((unsigned char)c < 0x20)
+			{
+				char escape[8];
+				std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int)(unsigned char)c);
+				output += escape;
+			}
+			else output += c;
+		}
+	}
+	output += '"';
+}
+
+void JsonValue::appendNumber(std::string & output, double value)
+{
+	if (!std::isfinite(value)) { output += "null"; return; }
+	char buffer[32];
+	for (int precision = 15; precision <= 17; precision++)
+	{
+		std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+		if (std::strtod(buffer, nullptr) == value) break;
+	}
+	output += buffer;
+}
@@ -0,0 +1,49 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// Minimal JSON value, used by the requests and responses of the daemon mode
+// Parsing throws a std::string describing the error. The numbers are stored as doubles
+class JsonValue
+{
+public:
+
+	enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+	Type type = NUL;											// Type of the value
+	bool boolean = false;										// Value of a boolean
+	double number = 0.;											// Value of a number
+	std::string text;											// Value of a string
+	std::vector <JsonValue> elements;							// Elements of an array
+	std::vector < std::pair <std::string, JsonValue> > members;	// Members of an object, in their order of appearance
+
+	// Member of an object with the given name (NULL if absent, or if the value is not an object)
+	const JsonValue * find(const std::string & name) const;
+
+	// Typed accessors, throwing a std::string if the value does not have the expected type
+	double getNumber() const;
+	int getInt() const;
+	bool getBoolean() const;
+	const std::string & getString() const;
+	const std::vector <JsonValue> & getArray() const;
+
+	// Array of numbers, as a vector of doubles
+	std::vector <double> getNumbers() const;
+
+	// Compact serialization of the value
+	std::string serialize() const;
+
+	// Parses a JSON document
+	static JsonValue parse(const std::string & document);
+
+	// Appends a string to a JSON document, with quotes and escapes
+	static void appendString(std::string & output, const std::string & value);
+
+	// Appends a number to a JSON document (shortest representation which reads back to the same double)
+	static void appendNumber(std::string & output, double value);
+};
+
+#endif
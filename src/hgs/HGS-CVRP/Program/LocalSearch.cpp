@@ -4,6 +4,7 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 {
 	this->penaltyCapacityLS = penaltyCapacityLS;
 	this->penaltyDurationLS = penaltyDurationLS;
+	nbRuns++;
 	loadIndividual(indiv);
 
 	// Shuffling the order of the nodes explored by the LS to allow for more diversity in the search
@@ -13,7 +14,36 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 		if (params.ran() % params.ap.nbGranular == 0)  // O(n/nbGranular) calls to the inner function on average, to achieve linear-time complexity overall
 			std::shuffle(params.correlatedVertices[i].begin(), params.correlatedVertices[i].end(), params.ran);
 
+	isFocused = false;
+	searchLoop();
+
+	// Register the solution produced by the LS in the individual
+	exportIndividual(indiv);
+}
+
+void LocalSearch::runFocused(Individual & indiv, const std::vector<int> & focusClients, double penaltyCapacityLS, double penaltyDurationLS)
+{
+	this->penaltyCapacityLS = penaltyCapacityLS;
+	this->penaltyDurationLS = penaltyDurationLS;
+	nbRuns++;
+	loadIndividual(indiv);
+	std::shuffle(orderNodes.begin(), orderNodes.end(), params.ran);
+	std::shuffle(orderRoutes.begin(), orderRoutes.end(), params.ran);
+
+	// All routes have been marked as modified at time 0 by loadIndividual: the focus routes are marked as modified at time 1, and the routes modified by the moves at a later time
+	nbMoves = 1;
+	for (int client : focusClients) clients[client].route->whenLastModified = 1;
+	isFocused = true;
+	searchLoop();
+	exportIndividual(indiv);
+}
+
+void LocalSearch::searchLoop()
+{
+	if (isAdaptiveMoveOrder) updateMoveOrder();
+	int nbMovesStart = nbMoves;
 	searchCompleted = false;
+	bool isTimeOver = false;
 	for (loopID = 0; !searchCompleted; loopID++)
 	{
 		if (loopID > 1) // Allows at least two loops since some moves involving empty routes are not checked at the first loop
@@ -22,7 +52,15 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 		/* CLASSICAL ROUTE IMPROVEMENT (RI) MOVES SUBJECT TO A PROXIMITY RESTRICTION */
 		for (int posU = 0; posU < params.nbClients; posU++)
 		{
+			// Checking the time limit every 64 nodes, such that a long local search on a large instance does not overshoot the deadline
+			if (posU % 64 == 0 && params.deadline.isOver())
+			{
+				isTimeOver = true;
+				break;
+			}
+
 			nodeU = &clients[orderNodes[posU]];
+			if (isFocused && nodeU->route->whenLastModified == 0) continue;
 			int lastTestRINodeU = nodeU->whenLastTestedRI;
 			nodeU->whenLastTestedRI = nbMoves;
 			for (int posV = 0; posV < (int)params.correlatedVertices[nodeU->cour].size(); posV++)
@@ -33,43 +71,66 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 					// Randomizing the order of the neighborhoods within this loop does not matter much as we are already randomizing the order of the node pairs (and it's not very common to find improving moves of different types for the same node pair)
 					setLocalVariablesRouteU();
 					setLocalVariablesRouteV();
-					if (move1()) continue; // RELOCATE
-					if (move2()) continue; // RELOCATE
-					if (move3()) continue; // RELOCATE
-					if (nodeUIndex <= nodeVIndex && move4()) continue; // SWAP
-					if (move5()) continue; // SWAP
-					if (nodeUIndex <= nodeVIndex && move6()) continue; // SWAP
-					if (intraRouteMove && move7()) continue; // 2-OPT
-					if (!intraRouteMove && move8()) continue; // 2-OPT*
-					if (!intraRouteMove && move9()) continue; // 2-OPT*
-
-					// Trying moves that insert nodeU directly after the depot
-					if (nodeV->prev->isDepot)
+					if (isAdaptiveMoveOrder)
+					{
+						if (applyMoves(ALL_RI_MOVES)) continue;
+					}
+					else
 					{
-						nodeV = nodeV->prev;
-						setLocalVariablesRouteV();
 						if (move1()) continue; // RELOCATE
 						if (move2()) continue; // RELOCATE
 						if (move3()) continue; // RELOCATE
+						if (nodeUIndex <= nodeVIndex && move4()) continue; // SWAP
+						if (move5()) continue; // SWAP
+						if (nodeUIndex <= nodeVIndex && move6()) continue; // SWAP
+						if (intraRouteMove && move7()) continue; // 2-OPT
 						if (!intraRouteMove && move8()) continue; // 2-OPT*
 						if (!intraRouteMove && move9()) continue; // 2-OPT*
 					}
+
+					// Trying moves that insert nodeU directly after the depot
+					if (nodeV->prev->isDepot)
+					{
+						nodeV = nodeV->prev;
+						setLocalVariablesRouteV();
+						if (isAdaptiveMoveOrder)
+						{
+							if (applyMoves(DEPOT_RI_MOVES)) continue;
+						}
+						else
+						{
+							if (move1()) continue; // RELOCATE
+							if (move2()) continue; // RELOCATE
+							if (move3()) continue; // RELOCATE
+							if (!intraRouteMove && move8()) continue; // 2-OPT*
+							if (!intraRouteMove && move9()) continue; // 2-OPT*
+						}
+					}
 				}
 			}
 
 			/* MOVES INVOLVING AN EMPTY ROUTE -- NOT TESTED IN THE FIRST LOOP TO AVOID INCREASING TOO MUCH THE FLEET SIZE */
 			if (loopID > 0 && !emptyRoutes.empty())
 			{
-				nodeV = routes[*emptyRoutes.begin()].depot;
+				nodeV = routes[emptyRoutes.front()].depot;
 				setLocalVariablesRouteU();
 				setLocalVariablesRouteV();
-				if (move1()) continue; // RELOCATE
-				if (move2()) continue; // RELOCATE
-				if (move3()) continue; // RELOCATE
-				if (move9()) continue; // 2-OPT*
+				if (isAdaptiveMoveOrder)
+				{
+					if (applyMoves(EMPTY_ROUTE_RI_MOVES)) continue;
+				}
+				else
+				{
+					if (move1()) continue; // RELOCATE
+					if (move2()) continue; // RELOCATE
+					if (move3()) continue; // RELOCATE
+					if (move9()) continue; // 2-OPT*
+				}
 			}
 		}
 
+		if (isTimeOver) break;
+
 		if (params.ap.useSwapStar == 1 && params.areCoordinatesProvided)
 		{
 			/* (SWAP*) MOVES LIMITED TO ROUTE PAIRS WHOSE CIRCLE SECTORS OVERLAP */
@@ -82,6 +143,7 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 				{
 					routeV = &routes[orderRoutes[rV]];
 					if (routeU->nbCustomers > 0 && routeV->nbCustomers > 0 && routeU->cour < routeV->cour
+						&& (!isFocused || routeU->whenLastModified > 0 || routeV->whenLastModified > 0)
 						&& (loopID == 0 || std::max<int>(routeU->whenLastModified, routeV->whenLastModified)
 							> lastTestSWAPStarRouteU))
 						if (CircleSector::overlap(routeU->sector, routeV->sector))
@@ -90,9 +152,91 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 			}
 		}
 	}
+	nbMovesLastRun = nbMoves - nbMovesStart;
+}
 
-	// Register the solution produced by the LS in the individual
-	exportIndividual(indiv);
+bool LocalSearch::applyMove(int move)
+{
+	switch (move)
+	{
+	case 1: return move1(); // RELOCATE
+	case 2: return move2(); // RELOCATE
+	case 3: return move3(); // RELOCATE
+	case 4: return nodeUIndex <= nodeVIndex && move4(); // SWAP
+	case 5: return move5(); // SWAP
+	case 6: return nodeUIndex <= nodeVIndex && move6(); // SWAP
+	case 7: return intraRouteMove && move7(); // 2-OPT
+	case 8: return !intraRouteMove && move8(); // 2-OPT*
+	case 9: return !intraRouteMove && move9(); // 2-OPT*
+	default: return false;
+	}
+}
+
+bool LocalSearch::applyMoves(int allowedMoves)
+{
+	bool isTimed = (--nbPairsBeforeSample == 0);
+	if (isTimed) nbPairsBeforeSample = 32;
+	for (int move : moveOrder)
+	{
+		if (!(allowedMoves >> move & 1)) continue;
+		MoveStatistics & statistics = moveStatistics[move];
+		double costBefore = routeU->duration + routeU->penalty + (intraRouteMove ? 0. : routeV->duration + routeV->penalty);
+		Deadline::Clock::time_point start;
+		if (isTimed) start = Deadline::Clock::now();
+		bool isApplied = applyMove(move);
+		if (isTimed)
+		{
+			statistics.sampledTime += std::max<double>((double)std::chrono::duration_cast<std::chrono::nanoseconds>(Deadline::Clock::now() - start).count() - clockOverhead, 1.);
+			statistics.nbSampledEvaluations++;
+		}
+		statistics.nbEvaluations++;
+		if (isApplied)
+		{
+			// The durations include the service times, whose sum over both routes does not change
+			statistics.nbSuccesses++;
+			statistics.totalGain += costBefore - (routeU->duration + routeU->penalty + (intraRouteMove ? 0. : routeV->duration + routeV->penalty));
+			return true;
+		}
+	}
+	return false;
+}
+
+void LocalSearch::updateMoveOrder()
+{
+	gainPerNanosecond.fill(0.);
+	for (int move = 1; move <= 9; move++)
+	{
+		MoveStatistics & statistics = moveStatistics[move];
+		statistics.nbEvaluations *= 0.99;
+		statistics.nbSuccesses *= 0.99;
+		statistics.totalGain *= 0.99;
+		statistics.sampledTime *= 0.99;
+		statistics.nbSampledEvaluations *= 0.99;
+		double timePerEvaluation = (statistics.nbSampledEvaluations > 0.) ? statistics.sampledTime / statistics.nbSampledEvaluations : 1.;
+		if (statistics.nbEvaluations > 0.) gainPerNanosecond[move] = statistics.totalGain / (statistics.nbEvaluations * std::max<double>(timePerEvaluation, 1.));
+	}
+
+	// Stable insertion sort of the nine neighborhoods by decreasing gain per nanosecond (std::stable_sort would allocate a temporary buffer at each call)
+	for (int i = 1; i < (int)moveOrder.size(); i++)
+	{
+		int move = moveOrder[i];
+		int j = i;
+		for (; j > 0 && gainPerNanosecond[moveOrder[j - 1]] < gainPerNanosecond[move]; j--) moveOrder[j] = moveOrder[j - 1];
+		moveOrder[j] = move;
+	}
+}
+
+void LocalSearch::printMoveStatistics()
+{
+	std::cout << "----- ORDER OF THE LOCAL SEARCH MOVES (GAIN PER NANOSECOND | SUCCESS RATE | NANOSECONDS PER EVALUATION):";
+	for (int move : moveOrder)
+	{
+		const MoveStatistics & statistics = moveStatistics[move];
+		double timePerEvaluation = (statistics.nbSampledEvaluations > 0.) ? statistics.sampledTime / statistics.nbSampledEvaluations : 0.;
+		std::printf(" move%d (%.2e | %.4f | %.1f)", move, (statistics.nbEvaluations > 0. && timePerEvaluation > 0.) ? statistics.totalGain / (statistics.nbEvaluations * timePerEvaluation) : 0.,
+			(statistics.nbEvaluations > 0.) ? statistics.nbSuccesses / statistics.nbEvaluations : 0., timePerEvaluation);
+	}
+	std::cout << std::endl;
 }
 
 void LocalSearch::setLocalVariablesRouteU()
@@ -707,12 +851,14 @@ void LocalSearch::updateRouteData(Route * myRoute)
 	if (myRoute->nbCustomers == 0)
 	{
 		myRoute->polarAngleBarycenter = 1.e30;
-		emptyRoutes.insert(myRoute->cour);
+		auto it = std::lower_bound(emptyRoutes.begin(), emptyRoutes.end(), myRoute->cour);
+		if (it == emptyRoutes.end() || *it != myRoute->cour) emptyRoutes.insert(it, myRoute->cour);
 	}
 	else
 	{
 		myRoute->polarAngleBarycenter = atan2(cumulatedY/(double)myRoute->nbCustomers - params.cli[0].coordY, cumulatedX/(double)myRoute->nbCustomers - params.cli[0].coordX);
-		emptyRoutes.erase(myRoute->cour);
+		auto it = std::lower_bound(emptyRoutes.begin(), emptyRoutes.end(), myRoute->cour);
+		if (it != emptyRoutes.end() && *it == myRoute->cour) emptyRoutes.erase(it);
 	}
 }
 
@@ -727,16 +873,17 @@ void LocalSearch::loadIndividual(const Individual & indiv)
 		Route * myRoute = &routes[r];
 		myDepot->prev = myDepotFin;
 		myDepotFin->next = myDepot;
-		if (!indiv.chromR[r].empty())
+		if (indiv.routeLength[r] > 0)
 		{
-			Node * myClient = &clients[indiv.chromR[r][0]];
+			const int * myRouteVisits = indiv.route(r);
+			Node * myClient = &clients[myRouteVisits[0]];
 			myClient->route = myRoute;
 			myClient->prev = myDepot;
 			myDepot->next = myClient;
-			for (int i = 1; i < (int)indiv.chromR[r].size(); i++)
+			for (int i = 1; i < indiv.routeLength[r]; i++)
 			{
 				Node * myClientPred = myClient;
-				myClient = &clients[indiv.chromR[r][i]]; 
+				myClient = &clients[myRouteVisits[i]]; 
 				myClient->prev = myClientPred;
 				myClientPred->next = myClient;
 				myClient->route = myRoute;
@@ -761,23 +908,22 @@ void LocalSearch::loadIndividual(const Individual & indiv)
 
 void LocalSearch::exportIndividual(Individual & indiv)
 {
-	std::vector < std::pair <double, int> > routePolarAngles ;
 	for (int r = 0; r < params.nbVehicles; r++)
-		routePolarAngles.push_back(std::pair <double, int>(routes[r].polarAngleBarycenter, r));
+		routePolarAngles[r] = std::pair <double, int>(routes[r].polarAngleBarycenter, r);
 	std::sort(routePolarAngles.begin(), routePolarAngles.end()); // empty routes have a polar angle of 1.e30, and therefore will always appear at the end
 
 	int pos = 0;
 	for (int r = 0; r < params.nbVehicles; r++)
 	{
-		indiv.chromR[r].clear();
+		indiv.routeOffset[r] = pos;
 		Node * node = depots[routePolarAngles[r].second].next;
 		while (!node->isDepot)
 		{
 			indiv.chromT[pos] = node->cour;
-			indiv.chromR[r].push_back(node->cour);
 			node = node->next;
 			pos++;
 		}
+		indiv.routeLength[r] = pos - indiv.routeOffset[r];
 	}
 
 	indiv.evaluateCompleteCost(params);
@@ -785,11 +931,15 @@ void LocalSearch::exportIndividual(Individual & indiv)
 
 LocalSearch::LocalSearch(Params & params) : params (params)
 {
+	nbMovesLastRun = 0;
+	nbRuns = 0;
 	clients = std::vector < Node >(params.nbClients + 1);
 	routes = std::vector < Route >(params.nbVehicles);
 	depots = std::vector < Node >(params.nbVehicles);
 	depotsEnd = std::vector < Node >(params.nbVehicles);
 	bestInsertClient = std::vector < std::vector <ThreeBestInsert> >(params.nbVehicles, std::vector <ThreeBestInsert>(params.nbClients + 1));
+	routePolarAngles = std::vector < std::pair <double, int> >(params.nbVehicles);
+	emptyRoutes.reserve(params.nbVehicles);
 
 	for (int i = 0; i <= params.nbClients; i++) 
 	{ 
@@ -809,5 +959,15 @@ LocalSearch::LocalSearch(Params & params) : params (params)
 	}
 	for (int i = 1 ; i <= params.nbClients ; i++) orderNodes.push_back(i);
 	for (int r = 0 ; r < params.nbVehicles ; r++) orderRoutes.push_back(r);
+	isAdaptiveMoveOrder = (params.ap.adaptiveMoveOrder == 1 && params.ap.deterministic == 0);
+	for (int move = 1; move <= 9; move++) moveOrder.push_back(move);
+	moveStatistics = std::vector < MoveStatistics >(10);
+	nbPairsBeforeSample = 32;
+	clockOverhead = 1.e30;
+	for (int i = 0; i < 100; i++)
+	{
+		Deadline::Clock::time_point start = Deadline::Clock::now();
+		clockOverhead = std::min<double>(clockOverhead, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Deadline::Clock::now() - start).count());
+	}
 }
 
@@ -24,6 +24,7 @@ SOFTWARE.*/
 #define LOCALSEARCH_H
 
 #include "Individual.h"
+#include <array>
 
 struct Node ;
 
@@ -106,6 +107,16 @@ struct SwapStarElement
 	Node * bestPositionV = NULL;
 };
 
+// Online statistics of one RI neighborhood, used to order the neighborhoods (decayed at each local search)
+struct MoveStatistics
+{
+	double nbEvaluations = 0.;			// Number of evaluations of the move
+	double nbSuccesses = 0.;			// Number of evaluations which led to an improving move
+	double totalGain = 0.;				// Total decrease of the penalized cost obtained by the move
+	double sampledTime = 0.;			// Total time (in nanoseconds) of the evaluations which have been timed
+	double nbSampledEvaluations = 0.;	// Number of evaluations which have been timed
+};
+
 // Main local learch structure
 class LocalSearch
 {
@@ -117,10 +128,21 @@ private:
 	int nbMoves;								// Total number of moves (RI and SWAP*) applied during the local search. Attention: this is not only a simple counter, it is also used to avoid repeating move evaluations
 	std::vector < int > orderNodes;				// Randomized order for checking the nodes in the RI local search
 	std::vector < int > orderRoutes;			// Randomized order for checking the routes in the SWAP* local search
-	std::set < int > emptyRoutes;				// indices of all empty routes
+	std::vector < int > emptyRoutes;			// indices of all empty routes, in increasing order (capacity reserved for all routes, such that updates do not allocate)
 	int loopID;									// Current loop index
+	bool isFocused;								// Tells whether the moves are restricted to the routes marked as modified (focused local search)
+
+	/* ORDER OF THE RI NEIGHBORHOODS */
+	enum { ALL_RI_MOVES = 0x3FE, DEPOT_RI_MOVES = 0x30E, EMPTY_ROUTE_RI_MOVES = 0x20E };	// Sets of neighborhoods (bit i for move i): all, after the depot of the route of V, and in an empty route
+	bool isAdaptiveMoveOrder;					// Tells whether the neighborhoods are ordered by their observed gain per nanosecond (ap.adaptiveMoveOrder, not in the deterministic mode), rather than in the fixed order move1...move9
+	std::vector < int > moveOrder;				// Order in which the neighborhoods (1 to 9) are evaluated for each pair of nodes
+	std::vector < MoveStatistics > moveStatistics;	// Statistics of each neighborhood (index 1 to 9) over the successive local searches
+	std::array < double, 10 > gainPerNanosecond;	// Observed gain per nanosecond of each neighborhood (index 1 to 9), used to sort moveOrder
+	int nbPairsBeforeSample;					// Number of node pairs before the next pair whose evaluations are timed
+	double clockOverhead;						// Time (in nanoseconds) measured between two consecutive readings of the clock, subtracted from the timed evaluations
 
 	/* THE SOLUTION IS REPRESENTED AS A LINKED LIST OF ELEMENTS */
+	std::vector < std::pair <double, int> > routePolarAngles;	// Routes sorted by polar angle when exporting the solution
 	std::vector < Node > clients;				// Elements representing clients (clients[0] is a sentinel and should not be accessed)
 	std::vector < Node > depots;				// Elements representing depots
 	std::vector < Node > depotsEnd;				// Duplicate of the depots to mark the end of the routes
@@ -165,6 +187,17 @@ private:
 	bool move8(); // If route(U) != route(V), replace (U,X) and (V,Y) by (U,V) and (X,Y)
 	bool move9(); // If route(U) != route(V), replace (U,X) and (V,Y) by (U,Y) and (V,X)
 
+	// Evaluates the RI neighborhood of index move for the current (U,V) pair, and applies the move if it is improving
+	bool applyMove(int move);
+
+	// Adaptive mode: evaluates the neighborhoods whose bit is set in allowedMoves, in the order moveOrder, and applies the first improving move
+	// The evaluations are counted, the gains are recorded, and the evaluations of one node pair out of 32 are timed (the fixed order is written out in searchLoop, as this is the innermost loop of the algorithm)
+	bool applyMoves(int allowedMoves);
+
+	// Decays the statistics and sorts the neighborhoods by decreasing gain per nanosecond of evaluation
+	// Since improving moves are rare, nearly all neighborhoods are evaluated for each node pair whatever their position, such that the estimates are refreshed without an explicit exploration term
+	void updateMoveOrder();
+
 	/* SUB-ROUTINES FOR EFFICIENT SWAP* EVALUATIONS */
 	bool swapStar(); // Calculates all SWAP* between routeU and routeV and apply the best improving move
 	double getCheapestInsertSimultRemoval(Node * U, Node * V, Node *& bestPosition); // Calculates the insertion cost and position in the route of V, where V is omitted
@@ -175,17 +208,30 @@ private:
 	static void swapNode(Node * U, Node * V) ;		// Solution update: Swap U and V							   
 	void updateRouteData(Route * myRoute);			// Updates the preprocessed data of a route
 
+	// Applies improving moves until a local minimum is reached (or until the time limit)
+	void searchLoop();
+
 	public:
 
+	int nbMovesLastRun;							// Number of moves applied by the last call to run or runFocused (statistics)
+	long long nbRuns;							// Number of calls to run or runFocused (statistics)
+
 	// Run the local search with the specified penalty values
 	void run(Individual & indiv, double penaltyCapacityLS, double penaltyDurationLS);
 
+	// Run a local search focused on the routes containing the given clients: only the moves involving these routes, and the routes modified during the search, are evaluated
+	// Used to re-optimize a solution after a local change, in a time which depends on the size of the change rather than on the size of the instance
+	void runFocused(Individual & indiv, const std::vector<int> & focusClients, double penaltyCapacityLS, double penaltyDurationLS);
+
 	// Loading an initial solution into the local search
 	void loadIndividual(const Individual & indiv);
 
 	// Exporting the LS solution into an individual and calculating the penalized cost according to the original penalty weights from Params
 	void exportIndividual(Individual & indiv);
 
+	// Prints the current order of the RI neighborhoods and their statistics (adaptive mode)
+	void printMoveStatistics();
+
 	// Constructor
 	LocalSearch(Params & params);
 };
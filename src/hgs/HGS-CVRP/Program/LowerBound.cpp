@@ -0,0 +1,271 @@
+#include "LowerBound.h"
+
+double LowerBound::evaluateStructure()
+{
+	int n = params.nbClients;
+
+	// Minimum spanning tree of the clients for the Lagrangian costs d(i,j) + multipliers[i] + multipliers[j] (Prim's algorithm in O(n^2), as the graph is complete)
+	std::fill(isInTree.begin(), isInTree.end(), false);
+	std::fill(keyPrim.begin(), keyPrim.end(), 1.e30);
+	treeEdges.clear();
+	double treeCost = 0.;
+	int current = 1;
+	isInTree[1] = true;
+	for (int k = 1; k < n; k++)
+	{
+		int next = -1;
+		for (int j = 1; j <= n; j++)
+		{
+			if (isInTree[j]) continue;
+			double cost = distance(current, j) + multipliers[current] + multipliers[j];
+			if (cost < keyPrim[j]) { keyPrim[j] = cost; parentPrim[j] = current; }
+			if (next == -1 || keyPrim[j] < keyPrim[next]) next = j;
+		}
+		isInTree[next] = true;
+		treeEdges.push_back({ keyPrim[next], next });
+		treeCost += keyPrim[next];
+		current = next;
+	}
+
+	// Depot edges for the Lagrangian costs d(0,i) + multipliers[i], each of them can be used twice
+	for (int i = 1; i <= n; i++) depotEdges[i - 1] = { distance(0, i) + multipliers[i], i };
+	std::sort(depotEdges.begin(), depotEdges.end());
+	std::sort(treeEdges.begin(), treeEdges.end(), std::greater < std::pair <double, int> >());
+
+	// Cheapest structure over the possible numbers of routes K: the K-1 longest tree edges are removed, and the K cheapest depot edges are used twice
+	double sumMultipliers = 0.;
+	for (int i = 1; i <= n; i++) sumMultipliers += multipliers[i];
+	double forestCost = treeCost;
+	double depotCost = 0.;
+	for (int k = 1; k < minNbRoutes; k++)
+	{
+		forestCost -= treeEdges[k - 1].first;
+		depotCost += 2. * depotEdges[k - 1].first;
+	}
+	double bestValue = 1.e30;
+	int bestNbRoutes = minNbRoutes;
+	for (int k = minNbRoutes; k <= maxNbRoutes; k++)
+	{
+		if (k > minNbRoutes) forestCost -= treeEdges[k - 2].first;
+		depotCost += 2. * depotEdges[k - 1].first;
+		if (forestCost + depotCost < bestValue)
+		{
+			bestValue = forestCost + depotCost;
+			bestNbRoutes = k;
+		}
+	}
+
+	// Degrees of the clients in this structure
+	std::fill(degree.begin(), degree.end(), 0);
+	for (int e = bestNbRoutes - 1; e < (int)treeEdges.size(); e++)
+	{
+		degree[treeEdges[e].second]++;
+		degree[parentPrim[treeEdges[e].second]]++;
+	}
+	for (int k = 0; k < bestNbRoutes; k++) degree[depotEdges[k].second] += 2;
+	return bestValue - 2. * sumMultipliers;
+}
+
+double LowerBound::evaluateQRoutes()
+{
+	int n = params.nbClients;
+
+	// Walks from the depot for the reduced costs d(j,i) - multipliers[i], by increasing load q (the demands are positive integers)
+	// For each load and last client, the best and second best walks with different predecessors are kept, such that a walk can always be extended without a 2-cycle j -> i -> j
+	for (int q = 1; q <= capacity; q++)
+	{
+		routeCost[q] = 1.e30;
+		for (int i = 1; i <= n; i++)
+		{
+			int index = q * (n + 1) + i;
+			walkCost1[index] = 1.e30; walkCost2[index] = 1.e30;
+			walkPred1[index] = -1; walkPred2[index] = -1;
+			int previousLoad = q - (int)params.cli[i].demand;
+			if (previousLoad < 0) continue;
+			if (previousLoad == 0)
+			{
+				walkCost1[index] = params.timeCost[0][i] - multipliers[i];
+				walkPred1[index] = 0;
+				walkLabel1[index] = 1;
+			}
+			else
+			{
+				for (int j = 1; j <= n; j++)
+				{
+					if (j == i) continue;
+					int previousIndex = previousLoad * (n + 1) + j;
+					double cost;
+					char label;
+					if (walkPred1[previousIndex] != i) { cost = walkCost1[previousIndex]; label = 1; }
+					else { cost = walkCost2[previousIndex]; label = 2; }
+					if (cost >= 1.e29) continue;
+					cost += params.timeCost[j][i] - multipliers[i];
+					if (cost < walkCost1[index])
+					{
+						walkCost2[index] = walkCost1[index]; walkPred2[index] = walkPred1[index]; walkLabel2[index] = walkLabel1[index];
+						walkCost1[index] = cost; walkPred1[index] = j; walkLabel1[index] = label;
+					}
+					else if (cost < walkCost2[index])
+					{
+						walkCost2[index] = cost; walkPred2[index] = j; walkLabel2[index] = label;
+					}
+				}
+			}
+
+			// Closing the walk at the depot
+			if (walkCost1[index] + params.timeCost[i][0] < routeCost[q])
+			{
+				routeCost[q] = walkCost1[index] + params.timeCost[i][0];
+				routeEnd[q] = i;
+			}
+		}
+	}
+
+	// Cheapest set of q-routes whose loads sum to the total demand (unbounded knapsack)
+	loadCost[0] = 0.;
+	for (int d = 1; d <= totalDemand; d++)
+	{
+		loadCost[d] = 1.e30;
+		for (int q = 1; q <= std::min<int>(capacity, d); q++)
+		{
+			if (loadCost[d - q] + routeCost[q] < loadCost[d])
+			{
+				loadCost[d] = loadCost[d - q] + routeCost[q];
+				loadChoice[d] = q;
+			}
+		}
+	}
+
+	// Number of visits of the clients in this set of q-routes
+	std::fill(degree.begin(), degree.end(), 0);
+	for (int d = totalDemand; d > 0; d -= loadChoice[d])
+	{
+		int q = loadChoice[d];
+		int client = routeEnd[q];
+		char label = 1;
+		while (client != 0)
+		{
+			degree[client]++;
+			int index = q * (n + 1) + client;
+			int pred = (label == 1) ? walkPred1[index] : walkPred2[index];
+			label = (label == 1) ? walkLabel1[index] : walkLabel2[index];
+			q -= (int)params.cli[client].demand;
+			client = pred;
+		}
+	}
+
+	double sumMultipliers = 0.;
+	for (int i = 1; i <= n; i++) sumMultipliers += multipliers[i];
+	return loadCost[totalDemand] + sumMultipliers;
+}
+
+void LowerBound::optimizeMultipliers(bool isQRoute)
+{
+	// The subgradient of the k-tree bound is degree[i] - 2, and the one of the q-route bound is 1 - degree[i] (number of visits)
+	double bestValue = -1.e30;
+	double stepFactor = 2.;
+	int nbIterNoImprovement = 0;
+	int nbIterMax = params.ap.deterministic ? 500 : 10000; // In the deterministic mode, the search waits for the bound
+	for (int nbIter = 0; !isStopRequested && !deadline.isOver() && stepFactor > 1.e-4 && nbIter < nbIterMax; nbIter++)
+	{
+		double value = isQRoute ? evaluateQRoutes() : evaluateStructure();
+		nbIterations++;
+		if (value > bestValue + MY_EPSILON)
+		{
+			bestValue = value;
+			nbIterNoImprovement = 0;
+			double newBound = isIntegral ? std::ceil(bestValue - MY_EPSILON) : bestValue;
+			if (newBound > bound) bound = newBound;
+		}
+		else if (++nbIterNoImprovement == 30) // Halving the step when the bound stagnates
+		{
+			stepFactor *= 0.5;
+			nbIterNoImprovement = 0;
+		}
+
+		// Subgradient step towards a target 5% above the best bound (Polyak's step size)
+		double squaredNorm = 0.;
+		for (int i = 1; i <= params.nbClients; i++)
+		{
+			int subgradient = isQRoute ? 1 - degree[i] : degree[i] - 2;
+			squaredNorm += subgradient * subgradient;
+		}
+		if (squaredNorm == 0.) break; // Each client is visited once: the structure is made of routes, and the bound cannot be improved
+		double step = stepFactor * (0.05 * std::abs(bestValue) + bestValue - value + MY_EPSILON) / squaredNorm;
+		for (int i = 1; i <= params.nbClients; i++) multipliers[i] += step * (isQRoute ? 1 - degree[i] : degree[i] - 2);
+	}
+}
+
+void LowerBound::compute()
+{
+	optimizeMultipliers(false);
+	if (isQRouteBound)
+	{
+		// Warm start: a multiplier pi of the degree constraint of the k-tree bound adds 2*pi to the cost of each visit, which corresponds to -2*pi for a visit in the q-route bound
+		for (int i = 1; i <= params.nbClients; i++) multipliers[i] *= -2.;
+		optimizeMultipliers(true);
+	}
+}
+
+bool LowerBound::isGapReached(double cost)
+{
+	// In the deterministic mode, each island only stops on its own solutions, as the time at which another island reports a solution depends on the timing of the threads
+	if (isGapReachedFlag && !params.ap.deterministic) return true;
+	double currentBound = bound;
+	if (currentBound <= 0. || cost > currentBound * (1. + params.ap.gap / 100.) + MY_EPSILON) return false;
+	isGapReachedFlag = true;
+	return true;
+}
+
+LowerBound::LowerBound(Params & params) : params(params), isStopRequested(false), bound(0.), isGapReachedFlag(false), nbIterations(0)
+{
+	int n = params.nbClients;
+	maxNbRoutes = std::min<int>(params.nbVehicles, n);
+	minNbRoutes = std::min<int>(maxNbRoutes, std::max<int>(1, (int)std::ceil(params.totalDemand / params.vehicleCapacity - MY_EPSILON)));
+	isIntegral = true;
+	for (int i = 0; i <= n && isIntegral; i++)
+		for (int j = 0; j <= n && isIntegral; j++)
+			isIntegral = (params.timeCost[i][j] == std::floor(params.timeCost[i][j]));
+
+	multipliers = std::vector <double>(n + 1, 0.);
+	degree = std::vector <int>(n + 1, 0);
+	keyPrim = std::vector <double>(n + 1, 1.e30);
+	parentPrim = std::vector <int>(n + 1, 0);
+	isInTree = std::vector <char>(n + 1, false);
+	treeEdges.reserve(n);
+	depotEdges = std::vector < std::pair <double, int> >(n);
+
+	// The q-route bound requires positive integer demands, and its dynamic program should remain fast enough to be iterated
+	capacity = (int)std::floor(params.vehicleCapacity + MY_EPSILON);
+	totalDemand = (int)std::round(params.totalDemand);
+	isQRouteBound = (capacity >= 1 && (double)capacity * (n + 1) <= 5.e6 && (double)capacity * n * n <= 2.e9 && (double)totalDemand * capacity <= 1.e9);
+	for (int i = 1; i <= n && isQRouteBound; i++)
+		isQRouteBound = (params.cli[i].demand >= 1. && params.cli[i].demand <= capacity && params.cli[i].demand == std::floor(params.cli[i].demand));
+	if (isQRouteBound)
+	{
+		walkCost1 = std::vector <double>((capacity + 1) * (n + 1), 1.e30);
+		walkCost2 = std::vector <double>((capacity + 1) * (n + 1), 1.e30);
+		walkPred1 = std::vector <int>((capacity + 1) * (n + 1), -1);
+		walkPred2 = std::vector <int>((capacity + 1) * (n + 1), -1);
+		walkLabel1 = std::vector <char>((capacity + 1) * (n + 1), 1);
+		walkLabel2 = std::vector <char>((capacity + 1) * (n + 1), 1);
+		routeCost = std::vector <double>(capacity + 1, 1.e30);
+		routeEnd = std::vector <int>(capacity + 1, 0);
+		loadCost = std::vector <double>(totalDemand + 1, 0.);
+		loadChoice = std::vector <int>(totalDemand + 1, 0);
+	}
+
+	// The computation before returning (deterministic mode) only has a tenth of the time limit, and is then only reproducible without time limit
+	deadline = params.deadline;
+	if (params.ap.deterministic && deadline.isLimited)
+		deadline.endTime = std::min<Deadline::Clock::time_point>(deadline.endTime,
+			Deadline::Clock::now() + std::chrono::duration_cast<Deadline::Clock::duration>(std::chrono::duration<double>(0.1 * params.ap.timeLimit)));
+	if (params.ap.deterministic) compute();
+	else thread = std::thread(&LowerBound::compute, this);
+}
+
+LowerBound::~LowerBound()
+{
+	isStopRequested = true;
+	if (thread.joinable()) thread.join();
+}
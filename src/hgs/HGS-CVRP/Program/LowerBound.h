@@ -0,0 +1,87 @@
+#ifndef LOWERBOUND_H
+#define LOWERBOUND_H
+
+#include "Params.h"
+#include <thread>
+#include <atomic>
+
+// Lower bound on the distance of the optimal solution, computed by a background thread in parallel with the search, and used to stop the search once the best solution is within ap.gap percent of it
+//
+// A solution with K routes is made of K paths covering the clients (a spanning forest of the clients with K components) and of 2K edges incident to the depot (a client alone in its route uses two of them)
+// The cheapest such structure is a minimum spanning tree of the clients without its K-1 longest edges, plus the cheapest depot edges where each client may be used twice (k-degree center tree bound)
+// K ranges from the bin-packing bound ceil(totalDemand / vehicleCapacity) to the number of vehicles, such that the capacity constraints are only taken into account through the number of routes
+// The degree constraints of the clients (two edges each) are relaxed in a Lagrangian way, and the multipliers are optimized by subgradient iterations (Christofides, Mingozzi and Toth, 1981)
+//
+// When the demands are integers, a second bound based on q-routes (Christofides, Mingozzi and Toth, 1981) then takes the capacity of each route into account:
+// a q-route is a walk from the depot back to the depot with a total load of q <= vehicleCapacity, which may visit a client several times (but without 2-cycles i -> j -> i),
+// and the cheapest set of q-routes whose loads sum to the total demand is found by dynamic programming, with Lagrangian multipliers on the number of visits of each client
+// The reported bound is the best of the two. Duration constraints are ignored, which keeps it valid
+class LowerBound
+{
+private:
+
+	Params & params;								// Problem parameters (only the distances and demands are read by the background thread)
+	Deadline deadline;								// Copy of the clock of the search, ending the computation with the time limit (or earlier in the deterministic mode)
+	std::thread thread;								// Background thread computing the bound
+	std::atomic <bool> isStopRequested;				// Tells the background thread to stop
+	std::atomic <double> bound;						// Best lower bound found so far (0 before the first one)
+	std::atomic <bool> isGapReachedFlag;			// Tells if a solution within the gap has been reported (shared by all the islands)
+	std::atomic <int> nbIterations;					// Number of subgradient iterations done so far
+	int minNbRoutes;								// Bin-packing bound on the number of routes
+	int maxNbRoutes;								// Maximum number of routes
+	bool isIntegral;								// Tells if all distances are integers, in which case the bound is rounded up
+	bool isQRouteBound;								// Tells if the q-route bound is computed (integer demands, and a dynamic program of reasonable size)
+	int capacity;									// Capacity of the vehicles, rounded down (q-route bound)
+	int totalDemand;								// Total demand (q-route bound)
+
+	/* DATA STRUCTURES OF THE LAGRANGIAN BOUND (USED BY THE BACKGROUND THREAD ONLY) */
+	std::vector <double> multipliers;				// Lagrangian multiplier of the degree constraint of each client
+	std::vector <int> degree;						// Degree of each client in the last minimum structure (number of visits for the q-route bound)
+	std::vector <double> keyPrim;					// Cheapest connection of each client to the tree in Prim's algorithm
+	std::vector <int> parentPrim;					// Client of the tree defining this connection
+	std::vector <char> isInTree;					// Tells if the client has been added to the tree
+	std::vector < std::pair <double, int> > treeEdges;	// Edges of the minimum spanning tree (cost, client whose parent defines the edge)
+	std::vector < std::pair <double, int> > depotEdges;	// Cost of the depot edge of each client
+	std::vector <double> walkCost1, walkCost2;		// (q-route bound) Best and second best reduced costs of a walk from the depot to client i with load q, at index q*(nbClients+1)+i, with different predecessors
+	std::vector <int> walkPred1, walkPred2;			// (q-route bound) Predecessor of client i in these walks (0 for the depot)
+	std::vector <char> walkLabel1, walkLabel2;		// (q-route bound) Label (1 or 2) of the predecessor used by these walks
+	std::vector <double> routeCost;					// (q-route bound) Reduced cost of the best q-route for each load q
+	std::vector <int> routeEnd;						// (q-route bound) Last client of this q-route
+	std::vector <double> loadCost;					// (q-route bound) Cheapest set of q-routes for each total load
+	std::vector <int> loadChoice;					// (q-route bound) Load of the last q-route in this set
+
+	// Symmetric distance between two vertices
+	double distance(int i, int j) const { return std::min<double>(params.timeCost[i][j], params.timeCost[j][i]); }
+
+	// Computes the cheapest structure for the current multipliers, fills the degrees of the clients in this structure, and returns the Lagrangian bound
+	double evaluateStructure();
+
+	// Computes the cheapest set of q-routes for the current multipliers, fills the number of visits of the clients in this set, and returns the Lagrangian bound
+	double evaluateQRoutes();
+
+	// Subgradient optimization of the multipliers of one of the two bounds, until convergence, until a stop is requested, or until the end of the time budget
+	void optimizeMultipliers(bool isQRoute);
+
+	// Computes the two bounds (function of the background thread)
+	void compute();
+
+public:
+
+	// Best lower bound found so far (0 if none yet)
+	double getBound() const { return bound.load(); }
+
+	// Number of subgradient iterations done so far
+	int getNbIterations() const { return nbIterations.load(); }
+
+	// Tells if the search can stop: a solution of the given cost is within ap.gap percent of the bound, or such a solution has already been reported (by another island)
+	bool isGapReached(double cost);
+
+	// Constructor: starts the background thread (in the deterministic mode, the bound is computed before returning, with fewer iterations, such that the stopping iteration does not depend on the timing of the threads)
+	// With a time limit, the computation before returning is limited to a tenth of the time limit, such that the bound never delays the search beyond it
+	LowerBound(Params & params);
+
+	// Destructor: stops the background thread
+	~LowerBound();
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include "Individual.h"
+#include <atomic>
+#include <memory>
+
+// Lock-free mailbox used to exchange individuals between threads (island model)
+// The mailbox contains a fixed number of preallocated slots. A sender claims an empty slot, copies the individual and publishes it.
+// The receiver collects the published slots and releases them. If all slots are occupied, the migrant is simply dropped, such that no thread ever waits for another.
+class Mailbox
+{
+private:
+
+	enum SlotState { EMPTY, WRITING, FULL, READING };
+
+	struct Slot
+	{
+		std::atomic <int> state;		// Current state of the slot (see SlotState)
+		Individual individual;			// Preallocated individual holding the migrant
+		Slot(Params & params) : state(EMPTY), individual(params, false) {}
+	};
+
+	std::vector < std::unique_ptr <Slot> > slots;
+
+public:
+
+	// Sends a copy of an individual. Can be called concurrently by several threads. Returns false if the mailbox is full (the individual is then dropped)
+	bool send(const Individual & indiv)
+	{
+		for (std::unique_ptr <Slot> & slot : slots)
+		{
+			int expected = EMPTY;
+			if (slot->state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire))
+			{
+				slot->individual.copySolution(indiv);
+				slot->state.store(FULL, std::memory_order_release);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Copies a waiting individual into indiv and removes it from the mailbox. Returns false if no individual is waiting
+	bool receive(Individual & indiv)
+	{
+		for (std::unique_ptr <Slot> & slot : slots)
+		{
+			int expected = FULL;
+			if (slot->state.compare_exchange_strong(expected, READING, std::memory_order_acquire))
+			{
+				indiv.copySolution(slot->individual);
+				slot->state.store(EMPTY, std::memory_order_release);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Constructor
+	Mailbox(Params & params, int nbSlots)
+	{
+		for (int i = 0; i < nbSlots; i++)
+			slots.emplace_back(new Slot(params));
+	}
+};
+
+#endif
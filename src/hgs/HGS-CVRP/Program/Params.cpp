@@ -6,7 +6,7 @@
 Params::Params(
 	const std::vector<double>& x_coords,
 	const std::vector<double>& y_coords,
-	const std::vector<std::vector<double>>& dist_mtx,
+	DistanceMatrix& dist_mtx,
 	const std::vector<double>& service_time,
 	const std::vector<double>& demands,
 	double vehicleCapacity,
@@ -16,23 +16,37 @@ Params::Params(
 	bool verbose,
 	const AlgorithmParameters& ap
 )
-	: ap(ap), isDurationConstraint(isDurationConstraint), nbVehicles(nbVeh), durationLimit(durationLimit),
-	  vehicleCapacity(vehicleCapacity), timeCost(dist_mtx), verbose(verbose)
+	: ap(ap), timeCost(dist_mtx), verbose(verbose)
 {
-	// This marks the starting time of the algorithm
-	startTime = clock();
+	loadInstance(x_coords, y_coords, service_time, demands, vehicleCapacity, durationLimit, nbVeh, isDurationConstraint, true);
+	resetSearch();
+}
 
+void Params::loadInstance(
+	const std::vector<double>& x_coords,
+	const std::vector<double>& y_coords,
+	const std::vector<double>& service_time,
+	const std::vector<double>& demands,
+	double vehicleCapacity,
+	double durationLimit,
+	int nbVeh,
+	bool isDurationConstraint,
+	bool isDistanceModified,
+	const std::vector<int> * newIndex
+)
+{
+	this->isDurationConstraint = isDurationConstraint;
+	this->nbVehicles = nbVeh;
+	this->durationLimit = durationLimit;
+	this->vehicleCapacity = vehicleCapacity;
 	nbClients = (int)demands.size() - 1; // Need to substract the depot from the number of nodes
 	totalDemand = 0.;
 	maxDemand = 0.;
 
-	// Initialize RNG
-	ran.seed(ap.seed);
-
 	// check if valid coordinates are provided
 	areCoordinatesProvided = (demands.size() == x_coords.size()) && (demands.size() == y_coords.size());
 
-	cli = std::vector<Client>(nbClients + 1);
+	cli.resize(nbClients + 1);
 	for (int i = 0; i <= nbClients; i++)
 	{
 		// If useSwapStar==false, x_coords and y_coords may be empty.
@@ -72,36 +86,32 @@ Params::Params(
 			std::cout << "----- FLEET SIZE SPECIFIED: SET TO " << nbVehicles << " VEHICLES" << std::endl;
 	}
 
-	// Calculation of the maximum distance
-	maxDist = 0.;
-	for (int i = 0; i <= nbClients; i++)
-		for (int j = 0; j <= nbClients; j++)
-			if (timeCost[i][j] > maxDist) maxDist = timeCost[i][j];
-
-	// Calculation of the correlated vertices for each customer (for the granular restriction)
-	correlatedVertices = std::vector<std::vector<int> >(nbClients + 1);
-	std::vector<std::set<int> > setCorrelatedVertices = std::vector<std::set<int> >(nbClients + 1);
-	std::vector<std::pair<double, int> > orderProximity;
-	for (int i = 1; i <= nbClients; i++)
+	// The neighbor lists only depend on the distances, and are kept when only the demands, capacities or fleet size change
+	if (newIndex != nullptr || isDistanceModified || (int)nearestVertices.size() != nbClients + 1)
 	{
-		orderProximity.clear();
-		for (int j = 1; j <= nbClients; j++)
-			if (i != j) orderProximity.emplace_back(timeCost[i][j], j);
-		std::sort(orderProximity.begin(), orderProximity.end());
-
-		for (int j = 0; j < std::min<int>(ap.nbGranular, nbClients - 1); j++)
+		// Calculation of the maximum distance
+		maxDist = 0.;
+		for (int i = 0; i <= nbClients; i++)
+			for (int j = 0; j <= nbClients; j++)
+				if (timeCost[i][j] > maxDist) maxDist = timeCost[i][j];
+	}
+	if (newIndex != nullptr) remapNeighborLists(*newIndex);
+	else if (isDistanceModified || (int)nearestVertices.size() != nbClients + 1)
+	{
+		// Calculation of the correlated vertices for each customer (for the granular restriction)
+		nearestVertices.resize(nbClients + 1);
+		reverseNearestVertices.resize(nbClients + 1);
+		correlatedVertices.resize(nbClients + 1);
+		for (std::vector<int> & reverseNearest : reverseNearestVertices) reverseNearest.clear();
+		for (int i = 1; i <= nbClients; i++)
 		{
-			// If i is correlated with j, then j should be correlated with i
-			setCorrelatedVertices[i].insert(orderProximity[j].second);
-			setCorrelatedVertices[orderProximity[j].second].insert(i);
+			computeNearestVertices(i);
+			for (int j : nearestVertices[i]) reverseNearestVertices[j].push_back(i);
 		}
+		for (int i = 1; i <= nbClients; i++)
+			computeCorrelatedVertices(i);
 	}
 
-	// Filling the vector of correlated vertices
-	for (int i = 1; i <= nbClients; i++)
-		for (int x : setCorrelatedVertices[i])
-			correlatedVertices[i].push_back(x);
-
 	// Safeguards to avoid possible numerical instability in case of instances containing arbitrarily small or large numerical values
 	if (maxDist < 0.1 || maxDist > 100000)
 		throw std::string(
@@ -112,12 +122,183 @@ Params::Params(
 	if (nbVehicles < std::ceil(totalDemand / vehicleCapacity))
 		throw std::string("Fleet size is insufficient to service the considered clients.");
 
+	if (verbose)
+		std::cout << "----- INSTANCE SUCCESSFULLY LOADED WITH " << nbClients << " CLIENTS AND " << nbVehicles << " VEHICLES" << std::endl;
+}
+
+void Params::resetSearch()
+{
+	// This marks the starting time of the algorithm
+	deadline.start(ap.timeLimit, ap.timeLimitConstruction);
+
+	// Initialize RNG
+	ran.seed(ap.seed);
+
 	// A reasonable scale for the initial values of the penalties
 	penaltyDuration = 1;
 	penaltyCapacity = std::max<double>(0.1, std::min<double>(1000., maxDist / maxDemand));
+}
 
-	if (verbose)
-		std::cout << "----- INSTANCE SUCCESSFULLY LOADED WITH " << nbClients << " CLIENTS AND " << nbVehicles << " VEHICLES" << std::endl;
+void Params::copyInstance(const Params & other)
+{
+	isDurationConstraint = other.isDurationConstraint;
+	nbClients = other.nbClients;
+	nbVehicles = other.nbVehicles;
+	durationLimit = other.durationLimit;
+	vehicleCapacity = other.vehicleCapacity;
+	totalDemand = other.totalDemand;
+	maxDemand = other.maxDemand;
+	maxDist = other.maxDist;
+	cli = other.cli;
+	nearestVertices = other.nearestVertices;
+	reverseNearestVertices = other.reverseNearestVertices;
+	correlatedVertices = other.correlatedVertices;
+	areCoordinatesProvided = other.areCoordinatesProvided;
+}
+
+void Params::computeNearestVertices(int i)
+{
+	std::vector<std::pair<double, int> > orderProximity;
+	orderProximity.reserve(nbClients);
+	for (int j = 1; j <= nbClients; j++)
+		if (i != j) orderProximity.emplace_back(timeCost[i][j], j);
+	int nbNearest = std::min<int>(ap.nbGranular, nbClients - 1);
+	std::partial_sort(orderProximity.begin(), orderProximity.begin() + nbNearest, orderProximity.end());
+	nearestVertices[i].clear();
+	for (int j = 0; j < nbNearest; j++)
+		nearestVertices[i].push_back(orderProximity[j].second);
+}
+
+void Params::computeCorrelatedVertices(int i)
+{
+	// If i is correlated with j, then j should be correlated with i
+	correlatedVertices[i] = nearestVertices[i];
+	correlatedVertices[i].insert(correlatedVertices[i].end(), reverseNearestVertices[i].begin(), reverseNearestVertices[i].end());
+	std::sort(correlatedVertices[i].begin(), correlatedVertices[i].end());
+	correlatedVertices[i].erase(std::unique(correlatedVertices[i].begin(), correlatedVertices[i].end()), correlatedVertices[i].end());
+}
+
+void Params::remapNeighborLists(const std::vector<int> & newIndex)
+{
+	if ((int)newIndex.size() != (int)nearestVertices.size()) throw std::string("The previous instance does not match the neighbor lists");
+	int nbKept = 0;
+	for (int i = 1; i < (int)newIndex.size(); i++)
+		if (newIndex[i] != -1) nbKept++;
+
+	// Moving the lists of the kept clients to their new index (which is never larger than their previous index), and translating their clients
+	// The lists remain sorted by distance, then by index, as computeNearestVertices sorts them
+	std::vector<bool> isRecomputed(nbClients + 1, true);
+	nearestVertices.resize(std::max<int>((int)nearestVertices.size(), nbClients + 1));
+	for (int i = 1; i < (int)newIndex.size(); i++)
+	{
+		if (newIndex[i] == -1) continue;
+		std::vector<int> & nearest = nearestVertices[newIndex[i]];
+		if (newIndex[i] != i) nearest.swap(nearestVertices[i]);
+		isRecomputed[newIndex[i]] = false;
+		for (int & j : nearest)
+		{
+			if (newIndex[j] == -1) { isRecomputed[newIndex[i]] = true; break; }
+			j = newIndex[j];
+		}
+	}
+	nearestVertices.resize(nbClients + 1);
+
+	// Merging the added clients into the lists of the kept clients, and computing the other lists
+	int nbNearest = std::min<int>(ap.nbGranular, nbClients - 1);
+	for (int i = 1; i <= nbClients; i++)
+	{
+		if (isRecomputed[i])
+		{
+			computeNearestVertices(i);
+			continue;
+		}
+		std::vector<int> & nearest = nearestVertices[i];
+		for (int j = nbKept + 1; j <= nbClients; j++)
+		{
+			// The added clients have the largest indices, and are thus placed after the kept clients at equal distance
+			if ((int)nearest.size() == nbNearest && timeCost[i][j] >= timeCost[i][nearest.back()]) continue;
+			int position = (int)nearest.size();
+			while (position > 0 && timeCost[i][j] < timeCost[i][nearest[position - 1]]) position--;
+			nearest.insert(nearest.begin() + position, j);
+			if ((int)nearest.size() > nbNearest) nearest.pop_back();
+		}
+	}
+
+	// Rebuilding the reverse and correlated vertices
+	reverseNearestVertices.resize(nbClients + 1);
+	correlatedVertices.resize(nbClients + 1);
+	for (std::vector<int> & reverseNearest : reverseNearestVertices) reverseNearest.clear();
+	for (int i = 1; i <= nbClients; i++)
+		for (int j : nearestVertices[i]) reverseNearestVertices[j].push_back(i);
+	for (int i = 1; i <= nbClients; i++)
+		computeCorrelatedVertices(i);
+}
+
+void Params::updateArcCosts(const std::vector<ArcCostUpdate> & updates)
+{
+	// All updates are checked before the distance matrix is modified, such that an invalid update leaves the instance unchanged
+	for (const ArcCostUpdate & update : updates)
+	{
+		if (update.from < 0 || update.from > nbClients || update.to < 0 || update.to > nbClients || update.from == update.to)
+			throw std::string("Invalid arc in the cost update");
+		if (!std::isfinite(update.cost) || update.cost < 0.)
+			throw std::string("Invalid cost in the cost update: the costs should be finite and non-negative");
+	}
+
+	// Patching the distance matrix (keeping the previous costs), and keeping track of the rows whose neighbor lists may change
+	std::vector<int> modifiedRows;
+	std::vector<double> previousCosts;
+	previousCosts.reserve(updates.size());
+	double previousMaxDist = maxDist;
+	bool isMaxDistDecreased = false;
+	for (const ArcCostUpdate & update : updates)
+	{
+		previousCosts.push_back(timeCost[update.from][update.to]);
+		if (timeCost[update.from][update.to] >= maxDist && update.cost < maxDist) isMaxDistDecreased = true;
+		timeCost.set(update.from, update.to, update.cost);
+		maxDist = std::max<double>(maxDist, update.cost);
+		if (update.from != 0 && update.to != 0) modifiedRows.push_back(update.from);
+	}
+	if (isMaxDistDecreased)
+	{
+		maxDist = 0.;
+		for (int i = 0; i <= nbClients; i++)
+			for (int j = 0; j <= nbClients; j++)
+				if (timeCost[i][j] > maxDist) maxDist = timeCost[i][j];
+	}
+
+	// Same safeguard on the scale of the distances as when loading the instance, restoring the previous costs if it fails (in reverse order, for arcs updated several times)
+	if (maxDist < 0.1 || maxDist > 100000)
+	{
+		for (int k = (int)updates.size() - 1; k >= 0; k--) timeCost.set(updates[k].from, updates[k].to, previousCosts[k]);
+		maxDist = previousMaxDist;
+		throw std::string(
+			"The distances are of very small or large scale. This could impact numerical stability. Please rescale the dataset and run again.");
+	}
+	std::sort(modifiedRows.begin(), modifiedRows.end());
+	modifiedRows.erase(std::unique(modifiedRows.begin(), modifiedRows.end()), modifiedRows.end());
+
+	// Updating the nearest vertices of the modified rows, and the correlated vertices of all clients involved
+	std::vector<int> affectedClients;
+	for (int i : modifiedRows)
+	{
+		for (int j : nearestVertices[i])
+		{
+			reverseNearestVertices[j].erase(std::find(reverseNearestVertices[j].begin(), reverseNearestVertices[j].end(), i));
+			affectedClients.push_back(j);
+		}
+		computeNearestVertices(i);
+		for (int j : nearestVertices[i])
+		{
+			reverseNearestVertices[j].push_back(i);
+			affectedClients.push_back(j);
+		}
+		affectedClients.push_back(i);
+	}
+	std::sort(affectedClients.begin(), affectedClients.end());
+	affectedClients.erase(std::unique(affectedClients.begin(), affectedClients.end()), affectedClients.end());
+	for (int i : affectedClients)
+		computeCorrelatedVertices(i);
 }
 
 
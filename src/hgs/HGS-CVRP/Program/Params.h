@@ -25,6 +25,8 @@ SOFTWARE.*/
 
 #include "CircleSector.h"
 #include "AlgorithmParameters.h"
+#include "Deadline.h"
+#include "DistanceMatrix.h"
 #include <string>
 #include <vector>
 #include <list>
@@ -38,6 +40,7 @@ SOFTWARE.*/
 #include <algorithm>
 #include <unordered_set>
 #include <random>
+#include <functional>
 #define MY_EPSILON 0.00001 // Precision parameter, used to avoid numerical instabilities
 #define PI 3.14159265359
 
@@ -50,6 +53,13 @@ struct Client
 	int polarAngle;			// Polar angle of the client around the depot, measured in degrees and truncated for convenience
 };
 
+struct ArcCostUpdate
+{
+	int from;				// Origin of the arc
+	int to;					// Destination of the arc
+	double cost;			// New cost of the arc
+};
+
 class Params
 {
 public:
@@ -62,8 +72,11 @@ public:
 	double penaltyCapacity;				// Penalty for one unit of capacity excess (adapted through the search)
 	double penaltyDuration;				// Penalty for one unit of duration excess (adapted through the search)
 
-	/* START TIME OF THE ALGORITHM */
-	clock_t startTime;                  // Start time of the optimization (set when Params is constructed)
+	/* START TIME AND TIME BUDGETS OF THE ALGORITHM */
+	Deadline deadline;                  // Wall-clock start time and time budgets of the optimization (started when Params is constructed, and by resetSearch)
+
+	/* OBSERVER OF THE SEARCH */
+	std::function <void(double, double)> onNewBestSolution;	// If set, called with the cost and elapsed time of each new best solution of a population (concurrently by the islands of the island model)
 
 	/* RANDOM NUMBER GENERATOR */       
 	std::minstd_rand ran;               // Using the fastest and simplest LCG. The quality of random numbers is not critical for the LS, but speed is
@@ -78,14 +91,16 @@ public:
 	double maxDemand;										// Maximum demand of a client
 	double maxDist;											// Maximum distance between two clients
 	std::vector< Client > cli ;								// Vector containing information on each client
-	const std::vector< std::vector< double > >& timeCost;	// Distance matrix
+	DistanceMatrix & timeCost;								// Distance matrix (shared with the caller, and modified by updateArcCosts)
+	std::vector< std::vector< int > > nearestVertices;		// For each client, its nbGranular closest clients
+	std::vector< std::vector< int > > reverseNearestVertices;	// For each client, the clients of which it is one of the nbGranular closest clients
 	std::vector< std::vector< int > > correlatedVertices;	// Neighborhood restrictions: For each client, list of nearby customers
 	bool areCoordinatesProvided;                            // Check if valid coordinates are provided
 
 	// Initialization from a given data set
 	Params(const std::vector<double>& x_coords,
 		const std::vector<double>& y_coords,
-		const std::vector<std::vector<double>>& dist_mtx,
+		DistanceMatrix& dist_mtx,
 		const std::vector<double>& service_time,
 		const std::vector<double>& demands,
 		double vehicleCapacity,
@@ -94,6 +109,40 @@ public:
 		bool isDurationConstraint,
 		bool verbose,
 		const AlgorithmParameters& ap);
+
+	// Loads the data of an instance, reusing the memory of the previous one (the distances are read from timeCost, which the caller has filled)
+	// The neighbor lists are only recomputed when isDistanceModified is true or the number of clients changes
+	// If newIndex is not NULL, the instance is a modification of the previous one, and the neighbor lists are updated rather than recomputed (see remapNeighborLists)
+	void loadInstance(const std::vector<double>& x_coords,
+		const std::vector<double>& y_coords,
+		const std::vector<double>& service_time,
+		const std::vector<double>& demands,
+		double vehicleCapacity,
+		double durationLimit,
+		int nbVeh,
+		bool isDurationConstraint,
+		bool isDistanceModified,
+		const std::vector<int> * newIndex = nullptr);
+
+	// Restarts the clock, the random number generator and the penalty coefficients before a new search
+	void resetSearch();
+
+	// Copies the data of the instance (but not the search state) from other parameters sharing the same distance matrix
+	void copyInstance(const Params & other);
+
+	// Computes the nbGranular closest clients of client i
+	void computeNearestVertices(int i);
+
+	// Computes the correlated vertices of client i from the nearest vertices
+	void computeCorrelatedVertices(int i);
+
+	// Updates the neighbor lists of the previous instance after a change of the set of clients, newIndex[i] giving the index of its client i in the new instance (-1 if removed)
+	// The kept clients are in the same order and followed by the added clients, and the distances between the kept clients are unchanged
+	// The lists of the kept clients are merged with the added clients, and only recomputed if they contained a removed client
+	void remapNeighborLists(const std::vector<int> & newIndex);
+
+	// Modifies some arc costs in the distance matrix, and updates the maximum distance and the neighbor lists of the clients concerned
+	void updateArcCosts(const std::vector<ArcCostUpdate> & updates);
 };
 #endif
 
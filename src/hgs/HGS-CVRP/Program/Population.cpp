@@ -1,11 +1,26 @@
 #include "Population.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 void Population::generatePopulation()
 {
 	if (params.verbose) std::cout << "----- BUILDING INITIAL POPULATION" << std::endl;
-	for (int i = 0; i < 4*params.ap.mu && (i == 0 || params.ap.timeLimit == 0 || (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC < params.ap.timeLimit) ; i++)
+	params.deadline.startConstruction();
+	if (threadPool != NULL)
+	{
+		generatePopulationParallel();
+		return;
+	}
+	for (int i = 0; i < 4*params.ap.mu && (i == 0 || !params.deadline.isConstructionOver()) ; i++)
 	{
 		Individual randomIndiv(params);
+		currentOrigin = ORIGIN_RANDOM;
+		if (isSweepIndividual(i))
+		{
+			randomIndiv.sweepTour(params);
+			currentOrigin = ORIGIN_SWEEP;
+		}
 		split.generalSplit(randomIndiv, params.nbVehicles);
 		localSearch.run(randomIndiv, params.penaltyCapacity, params.penaltyDuration);
 		addIndividual(randomIndiv, true);
@@ -15,39 +30,85 @@ void Population::generatePopulation()
 			if (randomIndiv.eval.isFeasible) addIndividual(randomIndiv, false);
 		}
 	}
+	currentOrigin = ORIGIN_SEARCH;
 }
 
-bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
+bool Population::isSweepIndividual(int i)
 {
-	if (updateFeasible)
+	// The polar angles are only computed when SWAP* is used with coordinates
+	if (params.ap.useSwapStar != 1 || !params.areCoordinatesProvided) return false;
+	return (int)((i + 1) * params.ap.sweepFraction) > (int)(i * params.ap.sweepFraction);
+}
+
+void Population::generatePopulationParallel()
+{
+	int nbIndividuals = 4 * params.ap.mu;
+	int nbWorkers = (int)workers->size();
+	if ((int)initialIndividuals.size() != nbIndividuals)
 	{
-		listFeasibilityLoad.push_back(indiv.eval.capacityExcess < MY_EPSILON);
-		listFeasibilityDuration.push_back(indiv.eval.durationExcess < MY_EPSILON);
-		listFeasibilityLoad.pop_front();
-		listFeasibilityDuration.pop_front();
+		initialIndividuals = std::vector <Individual>(nbIndividuals, Individual(params, false));
+		initialRepaired = std::vector <Individual>(nbIndividuals, Individual(params, false));
+		isInitialBuilt = std::vector <char>(nbIndividuals, false);
+		isInitialRepaired = std::vector <char>(nbIndividuals, false);
 	}
 
-	// Find the adequate subpopulation in relation to the individual feasibility
-	SubPopulation & subpop = (indiv.eval.isFeasible) ? feasibleSubpop : infeasibleSubpop;
+	// Each worker starts from the state of the master (granular neighborhoods and penalties), with a random number generator seeded by the master
+	// The individuals i = w, w+nbWorkers, w+2*nbWorkers, ... are built by worker w, such that the result only depends on the seed and number of threads
+	for (int w = 0; w < nbWorkers; w++)
+	{
+		Worker & worker = *(*workers)[w];
+		std::seed_seq seedSequence{ params.ran(), (std::mt19937::result_type)w };
+		worker.params.ran.seed(seedSequence);
+		worker.params.correlatedVertices = params.correlatedVertices;
+		worker.params.penaltyCapacity = params.penaltyCapacity;
+		worker.params.penaltyDuration = params.penaltyDuration;
+	}
+	threadPool->parallelFor(nbWorkers, [&](int w, int)
+	{
+		Worker & worker = *(*workers)[w];
+		for (int i = w; i < nbIndividuals; i += nbWorkers)
+		{
+			isInitialBuilt[i] = (i == 0 || !params.deadline.isConstructionOver());
+			isInitialRepaired[i] = false;
+			if (!isInitialBuilt[i]) continue;
+			Individual & randomIndiv = initialIndividuals[i];
+			if (isSweepIndividual(i)) randomIndiv.sweepTour(worker.params);
+			else
+			{
+				for (int j = 0; j < params.nbClients; j++) randomIndiv.chromT[j] = j + 1;
+				std::shuffle(randomIndiv.chromT.begin(), randomIndiv.chromT.end(), worker.params.ran);
+			}
+			worker.split.generalSplit(randomIndiv, params.nbVehicles);
+			worker.localSearch.run(randomIndiv, worker.params.penaltyCapacity, worker.params.penaltyDuration);
+			if (!randomIndiv.eval.isFeasible && worker.params.ran() % 2 == 0)  // Repair half of the solutions in case of infeasibility
+			{
+				initialRepaired[i].copySolution(randomIndiv);
+				worker.localSearch.run(initialRepaired[i], worker.params.penaltyCapacity*10., worker.params.penaltyDuration*10.);
+				isInitialRepaired[i] = initialRepaired[i].eval.isFeasible;
+			}
+		}
+	});
 
-	// Create a copy of the individual and updade the proximity structures calculating inter-individual distances
-	Individual * myIndividual = new Individual(indiv);
-	for (Individual * myIndividual2 : subpop)
+	// Insertion in the order of the indices, stopping at the first individual which has not been built before the time limit
+	for (int i = 0; i < nbIndividuals && isInitialBuilt[i]; i++)
 	{
-		double myDistance = brokenPairsDistance(*myIndividual,*myIndividual2);
-		myIndividual2->indivsPerProximity.insert({ myDistance, myIndividual });
-		myIndividual->indivsPerProximity.insert({ myDistance, myIndividual2 });
+		currentOrigin = isSweepIndividual(i) ? ORIGIN_SWEEP : ORIGIN_RANDOM;
+		addIndividual(initialIndividuals[i], true);
+		if (isInitialRepaired[i]) addIndividual(initialRepaired[i], false);
 	}
+	currentOrigin = ORIGIN_SEARCH;
+}
 
-	// Identify the correct location in the subpopulation and insert the individual
-	int place = (int)subpop.size();
-	while (place > 0 && subpop[place - 1]->eval.penalizedCost > indiv.eval.penalizedCost - MY_EPSILON) place--;
-	subpop.emplace(subpop.begin() + place, myIndividual);
+bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
+{
+	if (updateFeasible)
+	{
+		listFeasibilityLoad[posFeasibility] = (indiv.eval.capacityExcess < MY_EPSILON);
+		listFeasibilityDuration[posFeasibility] = (indiv.eval.durationExcess < MY_EPSILON);
+		posFeasibility = (posFeasibility + 1) % (int)listFeasibilityLoad.size();
+	}
 
-	// Trigger a survivor selection if the maximimum subpopulation size is exceeded
-	if ((int)subpop.size() > params.ap.mu + params.ap.lambda)
-		while ((int)subpop.size() > params.ap.mu)
-			removeWorstBiasedFitness(subpop);
+	insertIndividual(indiv);
 
 	// Track best solution
 	if (indiv.eval.isFeasible && indiv.eval.penalizedCost < bestSolutionRestart.eval.penalizedCost - MY_EPSILON)
@@ -56,7 +117,8 @@ bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
 		if (indiv.eval.penalizedCost < bestSolutionOverall.eval.penalizedCost - MY_EPSILON)
 		{
 			bestSolutionOverall = indiv;
-			searchProgress.push_back({ clock() - params.startTime , bestSolutionOverall.eval.penalizedCost });
+			searchProgress.push_back({ params.deadline.getElapsedTime() , bestSolutionOverall.eval.penalizedCost, currentOrigin });
+			if (params.onNewBestSolution) params.onNewBestSolution(searchProgress.back().cost, searchProgress.back().time);
 		}
 		return true;
 	}
@@ -64,10 +126,40 @@ bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
 		return false;
 }
 
+void Population::insertIndividual(const Individual & indiv)
+{
+	// Find the adequate subpopulation in relation to the individual feasibility
+	SubPopulation & subpop = (indiv.eval.isFeasible) ? feasibleSubpop : infeasibleSubpop;
+
+	// Copy the individual into a free element of the pool and updade the proximity structures calculating inter-individual distances
+	Individual * myIndividual = freeIndividuals.back();
+	freeIndividuals.pop_back();
+	myIndividual->copySolution(indiv);
+	for (Individual * myIndividual2 : subpop)
+	{
+		// Solutions with the same hash have the same edges: their distance is zero and does not need to be computed
+		double myDistance = (myIndividual->hash == myIndividual2->hash) ? 0. : brokenPairsDistance(*myIndividual,*myIndividual2);
+		std::pair <double, Individual*> proximity2 = { myDistance, myIndividual };
+		std::pair <double, Individual*> proximity = { myDistance, myIndividual2 };
+		myIndividual2->indivsPerProximity.insert(std::upper_bound(myIndividual2->indivsPerProximity.begin(), myIndividual2->indivsPerProximity.end(), proximity2), proximity2);
+		myIndividual->indivsPerProximity.insert(std::upper_bound(myIndividual->indivsPerProximity.begin(), myIndividual->indivsPerProximity.end(), proximity), proximity);
+	}
+
+	// Identify the correct location in the subpopulation and insert the individual
+	int place = (int)subpop.size();
+	while (place > 0 && subpop[place - 1]->eval.penalizedCost > indiv.eval.penalizedCost - MY_EPSILON) place--;
+	subpop.emplace(subpop.begin() + place, myIndividual);
+
+	// Trigger a survivor selection if the maximimum subpopulation size is exceeded
+	if ((int)subpop.size() > params.ap.mu + params.ap.lambda)
+		while ((int)subpop.size() > params.ap.mu)
+			removeWorstBiasedFitness(subpop);
+}
+
 void Population::updateBiasedFitnesses(SubPopulation & pop)
 {
 	// Ranking the individuals based on their diversity contribution (decreasing order of distance)
-	std::vector <std::pair <double, int> > ranking;
+	ranking.clear();
 	for (int i = 0 ; i < (int)pop.size(); i++) 
 		ranking.push_back({-averageBrokenPairsDistanceClosest(*pop[i],params.ap.nbClose),i});
 	std::sort(ranking.begin(), ranking.end());
@@ -110,7 +202,7 @@ void Population::removeWorstBiasedFitness(SubPopulation & pop)
 		}
 	}
 
-	// Removing the individual from the population and freeing memory
+	// Removing the individual from the population
 	pop.erase(pop.begin() + worstIndividualPosition); 
 
 	// Cleaning its distances from the other individuals in the population
@@ -121,19 +213,85 @@ void Population::removeWorstBiasedFitness(SubPopulation & pop)
 		indiv2->indivsPerProximity.erase(it);
 	}
 
-	// Freeing memory
-	delete worstIndividual; 
+	// Giving back the individual to the pool
+	freeIndividuals.push_back(worstIndividual);
 }
 
 void Population::restart()
 {
 	if (params.verbose) std::cout << "----- RESET: CREATING A NEW POPULATION -----" << std::endl;
-	for (Individual * indiv : feasibleSubpop) delete indiv ;
-	for (Individual * indiv : infeasibleSubpop) delete indiv;
+	double startTime = params.deadline.getElapsedTime();
+	if (params.ap.nbEliteRestart > 0) updateEliteArchive();
+	clearSubpopulations();
+	bestSolutionRestart = Individual(params);
+	if (nbElites > 0) generatePopulationFromElites();
+	else generatePopulation();
+	if (params.verbose) std::cout << "----- POPULATION CREATED IN " << params.deadline.getElapsedTime() - startTime << " SECONDS | FEASIBLE DIVERSITY " << getDiversity(feasibleSubpop) << std::endl;
+}
+
+void Population::reset()
+{
+	clearSubpopulations();
+	bestSolutionRestart = Individual(params);
+	bestSolutionOverall = Individual(params);
+	nbElites = 0;
+	searchProgress.clear();
+	std::fill(listFeasibilityLoad.begin(), listFeasibilityLoad.end(), true);
+	std::fill(listFeasibilityDuration.begin(), listFeasibilityDuration.end(), true);
+	posFeasibility = 0;
+	currentOrigin = ORIGIN_SEARCH;
+}
+
+void Population::updateEliteArchive()
+{
+	std::vector <const Individual *> candidates;
+	for (int k = 0; k < nbElites; k++) candidates.push_back(&eliteArchive[k]);
+	for (Individual * indiv : feasibleSubpop) candidates.push_back(indiv);
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Individual * indiv1, const Individual * indiv2) { return indiv1->eval.penalizedCost < indiv2->eval.penalizedCost; });
+
+	// Keeping the best candidates, skipping the clones (same hash as a solution already kept)
+	int nbKept = 0;
+	for (const Individual * candidate : candidates)
+	{
+		if (nbKept == params.ap.nbEliteRestart) break;
+		bool isClone = false;
+		for (int k = 0; k < nbKept && !isClone; k++) isClone = (eliteBuffer[k].hash == candidate->hash);
+		if (!isClone) eliteBuffer[nbKept++].copySolution(*candidate);
+	}
+	std::swap(eliteArchive, eliteBuffer);
+	nbElites = nbKept;
+}
+
+void Population::generatePopulationFromElites()
+{
+	if (params.verbose) std::cout << "----- WARM RESTART FROM " << nbElites << " ELITE SOLUTIONS" << std::endl;
+	params.deadline.startConstruction();
+	for (int k = 0; k < nbElites; k++) addIndividual(eliteArchive[k], false);
+
+	// The other individuals (up to mu, since they are of much better quality than random solutions) remove between 10% and 40% of the customers of a random elite solution
+	// Only the routes modified by the ruin and recreate are improved by the local search, instead of a complete local search from a random solution
+	currentOrigin = ORIGIN_RESTART;
+	for (int i = nbElites; i < params.ap.mu && !params.deadline.isConstructionOver(); i++)
+	{
+		const Individual & elite = eliteArchive[params.ran() % nbElites];
+		int nbRemoved = std::max<int>(1, params.nbClients * (10 + (int)(params.ran() % 31)) / 100);
+		reoptimization.ruinAndRecreate(restartIndividual, elite, nbRemoved);
+		addIndividual(restartIndividual, true);
+		if (!restartIndividual.eval.isFeasible && params.ran() % 2 == 0)  // Repair half of the solutions in case of infeasibility
+		{
+			reoptimization.repair(restartIndividual);
+			if (restartIndividual.eval.isFeasible) addIndividual(restartIndividual, false);
+		}
+	}
+	currentOrigin = ORIGIN_SEARCH;
+}
+
+void Population::clearSubpopulations()
+{
+	for (Individual * indiv : feasibleSubpop) freeIndividuals.push_back(indiv);
+	for (Individual * indiv : infeasibleSubpop) freeIndividuals.push_back(indiv);
 	feasibleSubpop.clear();
 	infeasibleSubpop.clear();
-	bestSolutionRestart = Individual(params);
-	generatePopulation();
 }
 
 void Population::managePenalties()
@@ -211,7 +369,7 @@ void Population::printState(int nbIter, int nbIterNoImprovement)
 {
 	if (params.verbose)
 	{
-		std::printf("It %6d %6d | T(s) %.2f", nbIter, nbIterNoImprovement, (double)(clock()-params.startTime)/(double)CLOCKS_PER_SEC);
+		std::printf("It %6d %6d | T(s) %.2f", nbIter, nbIterNoImprovement, params.deadline.getElapsedTime());
 
 		if (getBestFeasible() != NULL) std::printf(" | Feas %zu %.2f %.2f", feasibleSubpop.size(), getBestFeasible()->eval.penalizedCost, getAverageCost(feasibleSubpop));
 		else std::printf(" | NO-FEASIBLE");
@@ -228,11 +386,38 @@ void Population::printState(int nbIter, int nbIterNoImprovement)
 
 double Population::brokenPairsDistance(const Individual & indiv1, const Individual & indiv2)
 {
+	const int * succ1 = indiv1.successors.data();
+	const int * pred1 = indiv1.predecessors.data();
+	const int * succ2 = indiv2.successors.data();
+	const int * pred2 = indiv2.predecessors.data();
 	int differences = 0;
-	for (int j = 1; j <= params.nbClients; j++)
+	int j = 1;
+#ifdef __AVX2__
+	// Same tests as below on 8 clients at a time. The comparison masks are equal to -1 when true, and are therefore subtracted from the counters
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ones = _mm256_set1_epi32(-1);
+	__m256i counters = zero;
+	for (; j + 8 <= params.nbClients + 1; j += 8)
+	{
+		__m256i s1 = _mm256_loadu_si256((const __m256i *)(succ1 + j));
+		__m256i p1 = _mm256_loadu_si256((const __m256i *)(pred1 + j));
+		__m256i s2 = _mm256_loadu_si256((const __m256i *)(succ2 + j));
+		__m256i p2 = _mm256_loadu_si256((const __m256i *)(pred2 + j));
+		__m256i isEdgeKept = _mm256_or_si256(_mm256_cmpeq_epi32(s1, s2), _mm256_cmpeq_epi32(s1, p2));
+		__m256i isDepotIn2 = _mm256_or_si256(_mm256_cmpeq_epi32(p2, zero), _mm256_cmpeq_epi32(s2, zero));
+		counters = _mm256_sub_epi32(counters, _mm256_xor_si256(isEdgeKept, ones));
+		counters = _mm256_sub_epi32(counters, _mm256_andnot_si256(isDepotIn2, _mm256_cmpeq_epi32(p1, zero)));
+	}
+	__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(counters), _mm256_extracti128_si256(counters, 1));
+	sum = _mm_hadd_epi32(sum, sum);
+	sum = _mm_hadd_epi32(sum, sum);
+	differences = _mm_cvtsi128_si32(sum);
+#endif
+	// Branch-free formulation, which is also auto-vectorized by the compiler when AVX2 is not available
+	for (; j <= params.nbClients; j++)
 	{
-		if (indiv1.successors[j] != indiv2.successors[j] && indiv1.successors[j] != indiv2.predecessors[j]) differences++;
-		if (indiv1.predecessors[j] == 0 && indiv2.predecessors[j] != 0 && indiv2.successors[j] != 0) differences++;
+		differences += (succ1[j] != succ2[j]) & (succ1[j] != pred2[j]);
+		differences += (pred1[j] == 0) & (pred2[j] != 0) & (succ2[j] != 0);
 	}
 	return (double)differences / (double)params.nbClients;
 }
@@ -271,8 +456,193 @@ double Population::getAverageCost(const SubPopulation & pop)
 void Population::exportSearchProgress(std::string fileName, std::string instanceName)
 {
 	std::ofstream myfile(fileName);
-	for (std::pair<clock_t, double> state : searchProgress)
-		myfile << instanceName << ";" << params.ap.seed << ";" << state.second << ";" << (double)state.first / (double)CLOCKS_PER_SEC << std::endl;
+	const char * originNames[] = { "search", "random", "sweep", "restart" };
+	for (const SearchState & state : searchProgress)
+		myfile << instanceName << ";" << params.ap.seed << ";" << state.cost << ";" << state.time << ";" << originNames[state.origin] << std::endl;
+}
+
+// Helper functions for the binary snapshots
+template <typename T> static void appendValue(std::vector<char> & buffer, const T & value)
+{
+	const char * bytes = reinterpret_cast<const char *>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+static void appendSolution(std::vector<char> & buffer, const Individual & indiv)
+{
+	const char * chromT = reinterpret_cast<const char *>(indiv.chromT.data());
+	const char * routeOffset = reinterpret_cast<const char *>(indiv.routeOffset.data());
+	const char * routeLength = reinterpret_cast<const char *>(indiv.routeLength.data());
+	buffer.insert(buffer.end(), chromT, chromT + indiv.chromT.size() * sizeof(int));
+	buffer.insert(buffer.end(), routeOffset, routeOffset + indiv.routeOffset.size() * sizeof(int));
+	buffer.insert(buffer.end(), routeLength, routeLength + indiv.routeLength.size() * sizeof(int));
+}
+
+template <typename T> static void readValue(std::ifstream & inputFile, T & value)
+{
+	inputFile.read(reinterpret_cast<char *>(&value), sizeof(T));
+	if (!inputFile) throw std::string("Snapshot file is incomplete");
+}
+
+// Reads a solution and recomputes its cost (according to the current penalty coefficients), successors, predecessors and hash
+// The giant tour should be a permutation of the clients, and the routes should cover it without overlapping
+static void readSolution(std::ifstream & inputFile, Individual & indiv, const Params & params)
+{
+	inputFile.read(reinterpret_cast<char *>(indiv.chromT.data()), (std::streamsize)(indiv.chromT.size() * sizeof(int)));
+	inputFile.read(reinterpret_cast<char *>(indiv.routeOffset.data()), (std::streamsize)(indiv.routeOffset.size() * sizeof(int)));
+	inputFile.read(reinterpret_cast<char *>(indiv.routeLength.data()), (std::streamsize)(indiv.routeLength.size() * sizeof(int)));
+	if (!inputFile) throw std::string("Snapshot file is incomplete");
+	std::vector<char> isCovered(params.nbClients + 1, false);
+	for (int client : indiv.chromT)
+	{
+		if (client < 1 || client > params.nbClients || isCovered[client]) throw std::string("Snapshot file contains an invalid solution");
+		isCovered[client] = true;
+	}
+	std::fill(isCovered.begin(), isCovered.end(), false);
+	int nbCovered = 0;
+	for (int r = 0; r < params.nbVehicles; r++)
+	{
+		if (indiv.routeLength[r] < 0 || indiv.routeOffset[r] < 0 || indiv.routeOffset[r] + indiv.routeLength[r] > params.nbClients)
+			throw std::string("Snapshot file contains an invalid solution");
+		for (int pos = indiv.routeOffset[r]; pos < indiv.routeOffset[r] + indiv.routeLength[r]; pos++)
+		{
+			if (isCovered[pos]) throw std::string("Snapshot file contains an invalid solution");
+			isCovered[pos] = true;
+		}
+		nbCovered += indiv.routeLength[r];
+	}
+	if (nbCovered != params.nbClients) throw std::string("Snapshot file contains an invalid solution");
+	indiv.evaluateCompleteCost(params);
+}
+
+void Population::writeSnapshot(std::vector<char> & buffer, int nbIter, int nbIterNonProd)
+{
+	buffer.clear();
+	buffer.insert(buffer.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 8);
+	appendValue(buffer, params.nbClients);
+	appendValue(buffer, params.nbVehicles);
+
+	// Search counters and adaptive penalties
+	appendValue(buffer, nbIter);
+	appendValue(buffer, nbIterNonProd);
+	appendValue(buffer, params.deadline.getElapsedTime());
+	appendValue(buffer, params.penaltyCapacity);
+	appendValue(buffer, params.penaltyDuration);
+	appendValue(buffer, (int)listFeasibilityLoad.size());
+	for (int i = 0; i < (int)listFeasibilityLoad.size(); i++) buffer.push_back(listFeasibilityLoad[(posFeasibility + i) % listFeasibilityLoad.size()]);
+	for (int i = 0; i < (int)listFeasibilityDuration.size(); i++) buffer.push_back(listFeasibilityDuration[(posFeasibility + i) % listFeasibilityDuration.size()]);
+
+	// State of the random number generator
+	std::ostringstream randomStream;
+	randomStream << params.ran;
+	std::string randomState = randomStream.str();
+	appendValue(buffer, (int)randomState.size());
+	buffer.insert(buffer.end(), randomState.begin(), randomState.end());
+
+	// Subpopulations (ordered by penalized cost) and best solutions. Costs and distances are recomputed when reading
+	appendValue(buffer, (int)feasibleSubpop.size());
+	for (Individual * indiv : feasibleSubpop) appendSolution(buffer, *indiv);
+	appendValue(buffer, (int)infeasibleSubpop.size());
+	for (Individual * indiv : infeasibleSubpop) appendSolution(buffer, *indiv);
+	buffer.push_back(bestSolutionRestart.eval.penalizedCost < 1.e29);
+	if (bestSolutionRestart.eval.penalizedCost < 1.e29) appendSolution(buffer, bestSolutionRestart);
+	buffer.push_back(bestSolutionOverall.eval.penalizedCost < 1.e29);
+	if (bestSolutionOverall.eval.penalizedCost < 1.e29) appendSolution(buffer, bestSolutionOverall);
+	appendValue(buffer, nbElites);
+	for (int k = 0; k < nbElites; k++) appendSolution(buffer, eliteArchive[k]);
+
+	// History of the best solutions
+	appendValue(buffer, (int)searchProgress.size());
+	for (const SearchState & state : searchProgress)
+	{
+		appendValue(buffer, state.time);
+		appendValue(buffer, state.cost);
+		appendValue(buffer, state.origin);
+	}
+}
+
+void Population::readSnapshot(std::string fileName, int & nbIter, int & nbIterNonProd)
+{
+	std::ifstream inputFile(fileName, std::ios::binary);
+	if (!inputFile.is_open()) throw std::string("Impossible to open snapshot file: " + fileName);
+	char magic[8];
+	inputFile.read(magic, 8);
+	if (!inputFile || !std::equal(magic, magic + 8, SNAPSHOT_MAGIC)) throw std::string("Invalid snapshot file: " + fileName);
+	int nbClients, nbVehicles;
+	readValue(inputFile, nbClients);
+	readValue(inputFile, nbVehicles);
+	if (nbClients != params.nbClients || nbVehicles != params.nbVehicles) throw std::string("Snapshot file does not correspond to this instance and fleet size");
+
+	// Search counters and adaptive penalties
+	double elapsedTime;
+	int windowSize;
+	readValue(inputFile, nbIter);
+	readValue(inputFile, nbIterNonProd);
+	readValue(inputFile, elapsedTime);
+	readValue(inputFile, params.penaltyCapacity);
+	readValue(inputFile, params.penaltyDuration);
+	readValue(inputFile, windowSize);
+	if (windowSize != (int)listFeasibilityLoad.size()) throw std::string("Snapshot file does not correspond to the parameter nbIterPenaltyManagement");
+	for (char & isFeasible : listFeasibilityLoad) readValue(inputFile, isFeasible);
+	for (char & isFeasible : listFeasibilityDuration) readValue(inputFile, isFeasible);
+	posFeasibility = 0;
+
+	// State of the random number generator
+	// The state of the generator is a short text (a single number for std::minstd_rand), bounded to reject corrupted sizes before allocating
+	int randomStateSize;
+	readValue(inputFile, randomStateSize);
+	if (randomStateSize <= 0 || randomStateSize >= 65536) throw std::string("Invalid snapshot file: " + fileName);
+	std::string randomState(randomStateSize, ' ');
+	inputFile.read(&randomState[0], randomStateSize);
+	if (!inputFile) throw std::string("Snapshot file is incomplete");
+	std::istringstream randomStream(randomState);
+	if (!(randomStream >> params.ran)) throw std::string("Invalid snapshot file: " + fileName);
+
+	// Subpopulations, whose distances are recomputed during the insertion (the best solutions and their history are read afterwards, and no new best solution is reported)
+	clearSubpopulations();
+	Individual indiv(params, false);
+	for (int k = 0; k < 2; k++)
+	{
+		int nbIndividuals;
+		readValue(inputFile, nbIndividuals);
+		if (nbIndividuals < 0 || nbIndividuals > params.ap.mu + params.ap.lambda) throw std::string("Snapshot file does not correspond to the population size parameters");
+		for (int i = 0; i < nbIndividuals; i++)
+		{
+			readSolution(inputFile, indiv, params);
+			insertIndividual(indiv);
+		}
+	}
+
+	// Best solutions
+	char hasBestSolution;
+	bestSolutionRestart = Individual(params, false);
+	readValue(inputFile, hasBestSolution);
+	if (hasBestSolution) readSolution(inputFile, bestSolutionRestart, params);
+	bestSolutionOverall = Individual(params, false);
+	readValue(inputFile, hasBestSolution);
+	if (hasBestSolution) readSolution(inputFile, bestSolutionOverall, params);
+	readValue(inputFile, nbElites);
+	if (nbElites < 0 || nbElites > params.ap.nbEliteRestart) throw std::string("Snapshot file does not correspond to the parameter nbEliteRestart");
+	for (int k = 0; k < nbElites; k++) readSolution(inputFile, eliteArchive[k], params);
+
+	// History of the best solutions
+	int nbStates;
+	readValue(inputFile, nbStates);
+	if (nbStates < 0) throw std::string("Invalid snapshot file: " + fileName);
+	searchProgress.clear();
+	for (int i = 0; i < nbStates; i++) // The states are appended one by one, such that a corrupted number of states ends with an incomplete file rather than a large allocation
+	{
+		SearchState state;
+		readValue(inputFile, state.time);
+		readValue(inputFile, state.cost);
+		readValue(inputFile, state.origin);
+		if (state.origin < ORIGIN_SEARCH || state.origin > ORIGIN_RESTART) throw std::string("Invalid snapshot file: " + fileName);
+		searchProgress.push_back(state);
+	}
+
+	// The time limit includes the time spent before the interruption
+	params.deadline.shift(elapsedTime);
+	if (params.verbose) std::cout << "----- SEARCH RESUMED FROM SNAPSHOT " << fileName << " AT ITERATION " << nbIter << std::endl;
 }
 
 void Population::exportCVRPLibFormat(const Individual & indiv, std::string fileName)
@@ -280,12 +650,12 @@ void Population::exportCVRPLibFormat(const Individual & indiv, std::string fileN
 	std::ofstream myfile(fileName);
 	if (myfile.is_open())
 	{
-		for (int k = 0; k < (int)indiv.chromR.size(); k++)
+		for (int k = 0; k < (int)indiv.routeLength.size(); k++)
 		{
-			if (!indiv.chromR[k].empty())
+			if (indiv.routeLength[k] > 0)
 			{
 				myfile << "Route #" << k + 1 << ":"; // Route IDs start at 1 in the file format
-				for (int i : indiv.chromR[k]) myfile << " " << i;
+				for (int i = 0; i < indiv.routeLength[k]; i++) myfile << " " << indiv.route(k)[i];
 				myfile << std::endl;
 			}
 		}
@@ -294,14 +664,27 @@ void Population::exportCVRPLibFormat(const Individual & indiv, std::string fileN
 	else std::cout << "----- IMPOSSIBLE TO OPEN: " << fileName << std::endl;
 }
 
-Population::Population(Params & params, Split & split, LocalSearch & localSearch) : params(params), split(split), localSearch(localSearch), bestSolutionRestart(params), bestSolutionOverall(params)
+Population::Population(Params & params, Split & split, LocalSearch & localSearch) : params(params), split(split), localSearch(localSearch), bestSolutionRestart(params), bestSolutionOverall(params), reoptimization(params, localSearch), restartIndividual(params, false), threadPool(NULL), workers(NULL)
 {
-	listFeasibilityLoad = std::list<bool>(params.ap.nbIterPenaltyManagement, true);
-	listFeasibilityDuration = std::list<bool>(params.ap.nbIterPenaltyManagement, true);
-}
-
-Population::~Population()
-{
-	for (int i = 0; i < (int)feasibleSubpop.size(); i++) delete feasibleSubpop[i];
-	for (int i = 0; i < (int)infeasibleSubpop.size(); i++) delete infeasibleSubpop[i];
+	currentOrigin = ORIGIN_SEARCH;
+	eliteArchive = std::vector <Individual>(params.ap.nbEliteRestart, Individual(params, false));
+	eliteBuffer = std::vector <Individual>(params.ap.nbEliteRestart, Individual(params, false));
+	nbElites = 0;
+	listFeasibilityLoad = std::vector<char>(params.ap.nbIterPenaltyManagement, true);
+	listFeasibilityDuration = std::vector<char>(params.ap.nbIterPenaltyManagement, true);
+	posFeasibility = 0;
+
+	// Each subpopulation temporarily contains up to mu+lambda+1 individuals before survivor selection
+	int maxSubpopSize = params.ap.mu + params.ap.lambda + 1;
+	individualPool = std::vector <Individual>(2 * maxSubpopSize, Individual(params, false));
+	freeIndividuals.reserve(individualPool.size());
+	feasibleSubpop.reserve(maxSubpopSize);
+	infeasibleSubpop.reserve(maxSubpopSize);
+	ranking.reserve(maxSubpopSize);
+	searchProgress.reserve(SEARCH_PROGRESS_RESERVE);
+	for (Individual & indiv : individualPool)
+	{
+		indiv.indivsPerProximity.reserve(maxSubpopSize);
+		freeIndividuals.push_back(&indiv);
+	}
 }
\ No newline at end of file
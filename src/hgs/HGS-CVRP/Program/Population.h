@@ -26,9 +26,26 @@ SOFTWARE.*/
 #include "Individual.h"
 #include "LocalSearch.h"
 #include "Split.h"
+#include "ThreadPool.h"
+#include "Worker.h"
+#include "Reoptimization.h"
+#include <memory>
+
+#define SNAPSHOT_MAGIC "HGSSNAP3" // First 8 bytes of the snapshot files
+#define SEARCH_PROGRESS_RESERVE 1000 // Number of best solutions of the search progress stored without allocation (the log is kept complete, with amortized allocations, beyond)
 
 typedef std::vector <Individual*> SubPopulation ;
 
+// Origin of the successive best solutions recorded in the search progress
+enum SolutionOrigin { ORIGIN_SEARCH = 0, ORIGIN_RANDOM = 1, ORIGIN_SWEEP = 2, ORIGIN_RESTART = 3 };
+
+struct SearchState
+{
+	double time;				// Wall-clock time (in seconds) at which the solution was found
+	double cost;				// Penalized cost of the solution
+	int origin;					// SolutionOrigin: crossover and local search, construction from a random or sweep giant tour (followed by local search), or ruin and recreate of an elite solution at a warm restart
+};
+
 class Population
 {
    private:
@@ -38,11 +55,40 @@ class Population
    LocalSearch & localSearch;					// Local search structure
    SubPopulation feasibleSubpop;			    // Feasible subpopulation, kept ordered by increasing penalized cost
    SubPopulation infeasibleSubpop;		        // Infeasible subpopulation, kept ordered by increasing penalized cost
-   std::list <bool> listFeasibilityLoad ;		// Load feasibility of recent individuals generated by LS
-   std::list <bool> listFeasibilityDuration ;	// Duration feasibility of recent individuals generated by LS
-   std::vector<std::pair<clock_t, double>> searchProgress; // Keeps tracks of the time stamps of successive best solutions
+   std::vector <Individual> individualPool;     // Fixed-capacity pool holding the memory of all individuals of the subpopulations (allocated once, never resized)
+   std::vector <Individual*> freeIndividuals;   // Individuals of the pool which are not currently in a subpopulation
+   std::vector <char> listFeasibilityLoad ;		// Load feasibility of recent individuals generated by LS (circular buffer)
+   std::vector <char> listFeasibilityDuration ;	// Duration feasibility of recent individuals generated by LS (circular buffer)
+   int posFeasibility;							// Position of the oldest individual in the circular buffers of feasibility
+   std::vector <std::pair <double, int> > ranking;	// Individuals ranked by diversity contribution when updating the biased fitnesses
+   std::vector<SearchState> searchProgress;      // Keeps tracks of the time stamps (wall-clock seconds) and origins of successive best solutions
+   int currentOrigin;                           // Origin of the individuals currently inserted in the population
    Individual bestSolutionRestart;              // Best solution found during the current restart of the algorithm
    Individual bestSolutionOverall;              // Best solution found during the complete execution of the algorithm
+   std::vector <Individual> initialIndividuals;			// Individuals of the initial population built in parallel, after local search
+   std::vector <Individual> initialRepaired;			// Repaired individuals of the initial population built in parallel
+   std::vector <char> isInitialBuilt;					// Tells whether the initial individual has been built before the time limit
+   std::vector <char> isInitialRepaired;				// Tells whether the initial individual has been successfully repaired
+   Reoptimization reoptimization;						// Ruin and recreate of the elite solutions at warm restarts
+   std::vector <Individual> eliteArchive;				// Best distinct feasible solutions found before the last restarts (the first nbElites ones are valid)
+   std::vector <Individual> eliteBuffer;				// Buffer used to update the elite archive
+   int nbElites;										// Number of solutions in the elite archive
+   Individual restartIndividual;						// Individual built by ruin and recreate at warm restarts
+
+   // Moves all individuals of the subpopulations back to the pool
+   void clearSubpopulations();
+
+   // Tells if the i-th individual of an initial population is built from a sweep giant tour rather than a random one (a fraction ap.sweepFraction of them, if the polar angles are available)
+   bool isSweepIndividual(int i);
+
+   // Merges the best distinct feasible individuals of the population into the elite archive (at most ap.nbEliteRestart solutions)
+   void updateEliteArchive();
+
+   // Creates a new population made of the elite solutions and of ruin and recreate perturbations of these solutions, improved by a local search focused on the modified routes
+   void generatePopulationFromElites();
+
+   // Creates an initial population of individuals in parallel with the workers, and inserts them in a fixed order
+   void generatePopulationParallel();
 
    // Evaluates the biased fitness of all individuals in the population
    void updateBiasedFitnesses(SubPopulation & pop);
@@ -50,8 +96,14 @@ class Population
    // Removes the worst individual in terms of biased fitness
    void removeWorstBiasedFitness(SubPopulation & subpop);
 
+   // Inserts an individual in its subpopulation, with the survivor selection of addIndividual but without tracking the feasibility and the best solutions (used to restore a snapshot)
+   void insertIndividual (const Individual & indiv);
+
    public:
 
+   ThreadPool * threadPool;										// Threads used to build the initial population in parallel (NULL for a sequential construction)
+   std::vector < std::unique_ptr <Worker> > * workers;			// Split and local search structures of each thread
+
    // Creates an initial population of individuals
    void generatePopulation();
 
@@ -60,8 +112,12 @@ class Population
    bool addIndividual (const Individual & indiv, bool updateFeasible);
 
    // Cleans all solutions and generates a new initial population (only used when running HGS until a time limit, in which case the algorithm restarts until the time limit is reached)
+   // If ap.nbEliteRestart > 0 and feasible solutions have been found, this is a warm restart from the elite archive rather than a complete regeneration
    void restart();
 
+   // Empties the population, the best solutions, the elite archive and the search statistics, before a new search (keeping the memory of the individuals)
+   void reset();
+
    // Adaptation of the penalty parameters
    void managePenalties();
 
@@ -92,17 +148,23 @@ class Population
    // Returns the average solution value among the 50% best individuals in the subpopulation
    double getAverageCost(const SubPopulation & pop);
 
+   // History of solution improvements of the current search
+   const std::vector<SearchState> & getSearchProgress() const { return searchProgress; }
+
    // Exports in a file the history of solution improvements
    void exportSearchProgress(std::string fileName, std::string instanceName);
 
+   // Serializes the state of the search (subpopulations, penalties, feasibility windows, best solutions, elite archive, search progress, random number generator and iteration counters) in a compact binary snapshot
+   void writeSnapshot(std::vector<char> & buffer, int nbIter, int nbIterNonProd);
+
+   // Restores the state of the search from a snapshot file, and returns the iteration counters of the genetic algorithm
+   void readSnapshot(std::string fileName, int & nbIter, int & nbIterNonProd);
+
    // Exports an Individual in CVRPLib format
    void exportCVRPLibFormat(const Individual & indiv, std::string fileName);
 
    // Constructor
    Population(Params & params, Split & split, LocalSearch & localSearch);
-
-   // Destructor
-   ~Population();
 };
 
 #endif
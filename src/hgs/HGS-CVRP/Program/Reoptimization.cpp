@@ -0,0 +1,241 @@
+#include "Reoptimization.h"
+
+double Reoptimization::insertionCost(int c, int a, int b, int r)
+{
+	double deltaDistance = params.timeCost[a][c] + params.timeCost[c][b] - params.timeCost[a][b];
+	double newLoad = routeLoad[r] + params.cli[c].demand;
+	double newDuration = routeDuration[r] + deltaDistance + params.cli[c].serviceDuration;
+	return deltaDistance
+		+ (std::max<double>(0., newLoad - params.vehicleCapacity) - std::max<double>(0., routeLoad[r] - params.vehicleCapacity)) * params.penaltyCapacity
+		+ (std::max<double>(0., newDuration - params.durationLimit) - std::max<double>(0., routeDuration[r] - params.durationLimit)) * params.penaltyDuration;
+}
+
+void Reoptimization::insertCheapest(int c)
+{
+	int bestRoute = -1;
+	int bestPosition = -1;
+	double bestCost = 1.e30;
+
+	// Insertions before or after the correlated vertices which are already routed
+	for (int v : params.correlatedVertices[c])
+	{
+		int r = routeOf[v];
+		if (r == -1) continue;
+		int position = (int)(std::find(routes[r].begin(), routes[r].end(), v) - routes[r].begin());
+		int predecessor = (position > 0) ? routes[r][position - 1] : 0;
+		int successor = (position < (int)routes[r].size() - 1) ? routes[r][position + 1] : 0;
+		double costBefore = insertionCost(c, predecessor, v, r);
+		double costAfter = insertionCost(c, v, successor, r);
+		if (costBefore < bestCost) { bestCost = costBefore; bestRoute = r; bestPosition = position; }
+		if (costAfter < bestCost) { bestCost = costAfter; bestRoute = r; bestPosition = position + 1; }
+	}
+
+	// Insertion in an empty route
+	for (int r = 0; r < params.nbVehicles; r++)
+	{
+		if (routes[r].empty())
+		{
+			double cost = insertionCost(c, 0, 0, r);
+			if (cost < bestCost) { bestCost = cost; bestRoute = r; bestPosition = 0; }
+			break;
+		}
+	}
+
+	// If no correlated vertex is routed and all routes are used, all positions are considered
+	if (bestRoute == -1)
+	{
+		for (int r = 0; r < params.nbVehicles; r++)
+		{
+			for (int position = 0; position <= (int)routes[r].size(); position++)
+			{
+				int predecessor = (position > 0) ? routes[r][position - 1] : 0;
+				int successor = (position < (int)routes[r].size()) ? routes[r][position] : 0;
+				double cost = insertionCost(c, predecessor, successor, r);
+				if (cost < bestCost) { bestCost = cost; bestRoute = r; bestPosition = position; }
+			}
+		}
+	}
+
+	int predecessor = (bestPosition > 0) ? routes[bestRoute][bestPosition - 1] : 0;
+	int successor = (bestPosition < (int)routes[bestRoute].size()) ? routes[bestRoute][bestPosition] : 0;
+	routeLoad[bestRoute] += params.cli[c].demand;
+	routeDuration[bestRoute] += params.timeCost[predecessor][c] + params.timeCost[c][successor] - params.timeCost[predecessor][successor] + params.cli[c].serviceDuration;
+	routes[bestRoute].insert(routes[bestRoute].begin() + bestPosition, c);
+	routeOf[c] = bestRoute;
+	focusClients.push_back(c);
+}
+
+void Reoptimization::loadRoutes(const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & newIndex)
+{
+	int nbRoutes = 0;
+	for (const std::vector <int> & previousRoute : previousRoutes)
+		if (!previousRoute.empty()) nbRoutes++;
+	if (nbRoutes > params.nbVehicles) throw std::string("The previous solution has more routes than the number of vehicles");
+
+	// Translating the previous routes into the new instance, and focusing on the customers adjacent to the removed ones
+	// The buffers are reused from one call to the next, such that the route-based crossover does not allocate memory once their capacities have grown
+	routes.resize(params.nbVehicles);
+	for (std::vector <int> & route : routes) route.clear();
+	routeOf.assign(params.nbClients + 1, -1);
+	focusClients.clear();
+	int r = 0;
+	for (const std::vector <int> & previousRoute : previousRoutes)
+	{
+		if (previousRoute.empty()) continue;
+		bool isAfterRemoval = false;
+		for (int previousClient : previousRoute)
+		{
+			if (previousClient <= 0 || previousClient >= (int)newIndex.size()) throw std::string("Invalid customer index in the previous solution");
+			int client = newIndex[previousClient];
+			if (client == -1)
+			{
+				if (!routes[r].empty()) focusClients.push_back(routes[r].back());
+				isAfterRemoval = true;
+				continue;
+			}
+			if (client <= 0 || client > params.nbClients || routeOf[client] != -1) throw std::string("Invalid or repeated customer in the previous solution");
+			if (isAfterRemoval) focusClients.push_back(client);
+			isAfterRemoval = false;
+			routes[r].push_back(client);
+			routeOf[client] = r;
+		}
+		r++;
+	}
+
+	// Loads and durations of the routes
+	routeLoad.assign(params.nbVehicles, 0.);
+	routeDuration.assign(params.nbVehicles, 0.);
+	for (r = 0; r < params.nbVehicles; r++)
+	{
+		int predecessor = 0;
+		for (int client : routes[r])
+		{
+			routeLoad[r] += params.cli[client].demand;
+			routeDuration[r] += params.timeCost[predecessor][client] + params.cli[client].serviceDuration;
+			predecessor = client;
+		}
+		routeDuration[r] += params.timeCost[predecessor][0];
+	}
+}
+
+void Reoptimization::exportRoutes(Individual & result)
+{
+	int position = 0;
+	for (int r = 0; r < params.nbVehicles; r++)
+	{
+		result.routeOffset[r] = routes[r].empty() ? params.nbClients : position;
+		result.routeLength[r] = (int)routes[r].size();
+		for (int client : routes[r]) result.chromT[position++] = client;
+	}
+	result.evaluateCompleteCost(params);
+}
+
+std::vector <int> Reoptimization::getNewIndex(int previousN, int nbClients, const std::vector <int> & removedClients)
+{
+	std::vector <int> newIndex(previousN, 0);
+	for (int client : removedClients)
+	{
+		if (client <= 0 || client >= previousN) throw std::string("Invalid index of removed customer");
+		newIndex[client] = -1;
+	}
+	int nbKept = 0;
+	for (int i = 1; i < previousN; i++)
+		if (newIndex[i] != -1) newIndex[i] = ++nbKept;
+	if (nbKept > nbClients) throw std::string("The new instance does not contain all the customers which have not been removed");
+	return newIndex;
+}
+
+void Reoptimization::run(Individual & result, const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & newIndex)
+{
+	// Cheapest insertion of the new customers
+	loadRoutes(previousRoutes, newIndex);
+	for (int client = 1; client <= params.nbClients; client++)
+		if (routeOf[client] == -1) insertCheapest(client);
+
+	// Building the individual and improving it with a focused local search (and a repair in case of infeasibility)
+	exportRoutes(result);
+	if (focusClients.empty()) return;
+	localSearch.runFocused(result, focusClients, params.penaltyCapacity, params.penaltyDuration);
+	if (!result.eval.isFeasible)
+		localSearch.runFocused(result, focusClients, params.penaltyCapacity*10., params.penaltyDuration*10.);
+}
+
+void Reoptimization::updateArcCosts(Individual & solution, const std::vector <ArcCostUpdate> & updates)
+{
+	// Identifying the clients concerned by the modified arcs before patching the distance matrix
+	focusClients.clear();
+	for (const ArcCostUpdate & update : updates)
+	{
+		if (update.from < 0 || update.from > params.nbClients || update.to < 0 || update.to > params.nbClients || update.from == update.to)
+			throw std::string("Invalid arc in the cost update");
+		bool isArcUsed = (update.from == 0) ? (update.to != 0 && solution.predecessors[update.to] == 0) : (solution.successors[update.from] == update.to);
+		if (isArcUsed || update.cost < params.timeCost[update.from][update.to])
+		{
+			if (update.from != 0) focusClients.push_back(update.from);
+			if (update.to != 0) focusClients.push_back(update.to);
+		}
+	}
+
+	params.updateArcCosts(updates);
+	solution.evaluateCompleteCost(params);
+	if (focusClients.empty()) return;
+	localSearch.runFocused(solution, focusClients, params.penaltyCapacity, params.penaltyDuration);
+	if (!solution.eval.isFeasible)
+		localSearch.runFocused(solution, focusClients, params.penaltyCapacity*10., params.penaltyDuration*10.);
+}
+
+void Reoptimization::ruinAndRecreate(Individual & result, const Individual & indiv, int nbRemoved)
+{
+	nbRemoved = std::min<int>(nbRemoved, params.nbClients);
+	removedClients.clear();
+	ruinIndex.resize(params.nbClients + 1);
+	for (int i = 0; i <= params.nbClients; i++) ruinIndex[i] = i;
+	for (int nbRemovedSoFar = 0; nbRemovedSoFar < nbRemoved; )
+	{
+		int seedClient = 1 + params.ran() % params.nbClients;
+		if (ruinIndex[seedClient] == -1) continue;
+		ruinIndex[seedClient] = -1;
+		removedClients.push_back(seedClient);
+		nbRemovedSoFar++;
+		for (int j : params.nearestVertices[seedClient])
+		{
+			if (nbRemovedSoFar == nbRemoved) break;
+			if (ruinIndex[j] != -1) { ruinIndex[j] = -1; removedClients.push_back(j); nbRemovedSoFar++; }
+		}
+	}
+
+	ruinedRoutes.resize(params.nbVehicles);
+	for (int r = 0; r < params.nbVehicles; r++)
+		ruinedRoutes[r].assign(indiv.route(r), indiv.route(r) + indiv.routeLength[r]);
+	loadRoutes(ruinedRoutes, ruinIndex);
+
+	// Cheapest insertion of the removed customers in a random order, followed by a focused local search (the repair is left to the caller)
+	std::shuffle(removedClients.begin(), removedClients.end(), params.ran);
+	for (int client : removedClients) insertCheapest(client);
+	exportRoutes(result);
+	localSearch.runFocused(result, focusClients, params.penaltyCapacity, params.penaltyDuration);
+}
+
+void Reoptimization::completeRoutes(Individual & result, const std::vector < std::vector <int> > & partialRoutes)
+{
+	ruinIndex.resize(params.nbClients + 1);
+	for (int i = 0; i <= params.nbClients; i++) ruinIndex[i] = i;
+	loadRoutes(partialRoutes, ruinIndex);
+	removedClients.clear();
+	for (int client = 1; client <= params.nbClients; client++)
+		if (routeOf[client] == -1) removedClients.push_back(client);
+	std::shuffle(removedClients.begin(), removedClients.end(), params.ran);
+	for (int client : removedClients) insertCheapest(client);
+	exportRoutes(result);
+}
+
+void Reoptimization::repair(Individual & indiv)
+{
+	localSearch.runFocused(indiv, focusClients, params.penaltyCapacity*10., params.penaltyDuration*10.);
+}
+
+Reoptimization::Reoptimization(Params & params, LocalSearch & localSearch) : params(params), localSearch(localSearch)
+{
+	focusClients.reserve(params.nbClients);
+	removedClients.reserve(params.nbClients);
+}
@@ -0,0 +1,66 @@
+#ifndef REOPTIMIZATION_H
+#define REOPTIMIZATION_H
+
+#include "LocalSearch.h"
+#include "Individual.h"
+
+// Updates an existing solution after a change of the set of customers (added and removed customers) or of some arc costs, without a complete re-solve
+// The added customers are inserted at their cheapest position next to their correlated vertices, and the solution is then improved by a local search focused on the modified routes
+class Reoptimization
+{
+private:
+
+	Params & params;								// Problem parameters (of the new instance)
+	LocalSearch & localSearch;						// Local search structure
+	std::vector < std::vector <int> > routes;		// Routes of the solution being updated
+	std::vector < int > routeOf;					// Route containing each customer (-1 if not yet routed)
+	std::vector < double > routeLoad;				// Load of each route
+	std::vector < double > routeDuration;			// Duration (distance and service) of each route
+	std::vector < int > focusClients;				// Customers whose routes have been modified
+	std::vector < std::vector <int> > ruinedRoutes;	// Routes of the solution being ruined, as input of run
+	std::vector < int > ruinIndex;					// Index of each customer after the ruin (itself, or -1 if removed)
+	std::vector < int > removedClients;				// Customers removed by the ruin
+
+	// Penalized cost of inserting customer c between a and b in route r
+	double insertionCost(int c, int a, int b, int r);
+
+	// Inserts customer c at its cheapest position
+	void insertCheapest(int c);
+
+	// Translates the previous routes into routes of the new instance (see run), focusing on the customers adjacent to the removed ones
+	void loadRoutes(const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & newIndex);
+
+	// Copies the routes into the individual, and evaluates it
+	void exportRoutes(Individual & result);
+
+public:
+
+	// Index in the new instance (of nbClients clients) of each node of the previous instance (of previousN nodes), given the clients of the previous instance which have been removed (-1 for these clients)
+	// The kept clients remain in the same order, and the added clients follow them
+	static std::vector <int> getNewIndex(int previousN, int nbClients, const std::vector <int> & removedClients);
+
+	// Updates a solution of the previous instance into a solution of the new instance (params)
+	// previousRoutes contains the routes with the customer indices of the previous instance, and newIndex[i] gives the index in the new instance of customer i of the previous instance (-1 if it has been removed)
+	// The customers of the new instance which do not appear in previousRoutes are inserted
+	void run(Individual & result, const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & newIndex);
+
+	// Modifies some arc costs (see Params::updateArcCosts), re-evaluates the solution, and improves it by a local search focused on the routes which contain a modified arc, or a client of an arc whose cost decreased
+	void updateArcCosts(Individual & solution, const std::vector <ArcCostUpdate> & updates);
+
+	// Ruin and recreate perturbation of a solution, used to rebuild a population from elite solutions
+	// Clusters made of a random customer and its nearest customers are removed until nbRemoved customers are removed, then they are inserted back at their cheapest position in a random order
+	// The result is improved by a local search focused on the modified routes, but not repaired if infeasible
+	void ruinAndRecreate(Individual & result, const Individual & indiv, int nbRemoved);
+
+	// Completes routes which do not contain all customers into a solution, by inserting the missing customers at their cheapest position in a random order (without local search)
+	// Used by the route-based crossover
+	void completeRoutes(Individual & result, const std::vector < std::vector <int> > & partialRoutes);
+
+	// Repairs the result of the last ruinAndRecreate with a focused local search using ten times larger penalties
+	void repair(Individual & indiv);
+
+	// Constructor
+	Reoptimization(Params & params, LocalSearch & localSearch);
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "Solver.h"
+
+void Solver::prepareSearchStructures()
+{
+	if (genetic && nbClientsGenetic == params->nbClients && nbVehiclesGenetic == params->nbVehicles)
+		genetic->reset();
+	else
+	{
+		genetic.reset(); // The previous structures (and their threads) are released before the new ones are allocated
+		genetic.reset(new Genetic(*params));
+		nbClientsGenetic = params->nbClients;
+		nbVehiclesGenetic = params->nbVehicles;
+	}
+}
+
+bool Solver::loadData(int n, const double * x, const double * y, const double * dist_mtx, int stride, bool isBorrowed, const double * serv_time, const double * dem, bool isRoundingInteger)
+{
+	// The neighbor lists are recomputed after a failed load, since they may not match the distances anymore
+	bool wasInstanceLoaded = isInstanceLoaded;
+	isInstanceLoaded = false;
+	islandModel.reset();
+	if (n < 2) throw std::string("The instance should contain a depot and at least one client");
+	if (x != nullptr && y != nullptr)
+	{
+		coordX.assign(x, x + n);
+		coordY.assign(y, y + n);
+	}
+	else
+	{
+		if (dist_mtx == nullptr) throw std::string("Either the coordinates or the distance matrix should be provided");
+		coordX.clear();
+		coordY.clear();
+	}
+	serviceTime.assign(serv_time, serv_time + n);
+	demands.assign(dem, dem + n);
+
+	// Filling the distance matrix in place (or borrowing the matrix of the caller), and detecting whether the distances have changed since the previous instance
+	bool isDistanceModified = (!wasInstanceLoaded || distanceMatrix.getSize() != n || distanceMatrix.isBorrowed());
+	if (isBorrowed)
+	{
+		if (dist_mtx == nullptr || stride < n) throw std::string("A borrowed distance matrix should be given with a stride of at least n");
+		distanceMatrix.borrow(dist_mtx, n, stride);
+		isDistanceModified = true;
+	}
+	else
+	{
+		if (isDistanceModified) distanceMatrix.resize(n);
+		for (int i = 0; i < n; i++)
+		{
+			for (int j = 0; j < n; j++)
+			{
+				double distance;
+				if (dist_mtx != nullptr) distance = dist_mtx[(size_t)stride * i + j];
+				else
+				{
+					distance = std::sqrt((x[i] - x[j])*(x[i] - x[j]) + (y[i] - y[j])*(y[i] - y[j]));
+					if (isRoundingInteger) distance = std::round(distance);
+				}
+				if (isDistanceModified || distanceMatrix[i][j] != distance)
+				{
+					distanceMatrix.set(i, j, distance);
+					isDistanceModified = true;
+				}
+			}
+		}
+	}
+	return isDistanceModified;
+}
+
+void Solver::setInstance(int n, const double * x, const double * y, const double * dist_mtx, int stride, bool isBorrowed, const double * serv_time, const double * dem,
+	double vehicleCapacity, double durationLimit, bool isRoundingInteger, bool isDurationConstraint, int nbVeh)
+{
+	bool isDistanceModified = loadData(n, x, y, dist_mtx, stride, isBorrowed, serv_time, dem, isRoundingInteger);
+	if (!params) params.reset(new Params(coordX, coordY, distanceMatrix, serviceTime, demands, vehicleCapacity, durationLimit, nbVeh, isDurationConstraint, verbose, ap));
+	else params->loadInstance(coordX, coordY, serviceTime, demands, vehicleCapacity, durationLimit, nbVeh, isDurationConstraint, isDistanceModified);
+	isInstanceLoaded = true;
+}
+
+const Individual * Solver::reoptimize(int n, const double * x, const double * y, const double * dist_mtx, const double * serv_time, const double * dem,
+	double vehicleCapacity, double durationLimit, bool isRoundingInteger, bool isDurationConstraint, int nbVeh,
+	const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & removedClients)
+{
+	if (!isInstanceLoaded) throw std::string("No instance has been loaded in the solver");
+	std::vector <int> newIndex = Reoptimization::getNewIndex(params->nbClients + 1, n - 1, removedClients);
+	loadData(n, x, y, dist_mtx, n, false, serv_time, dem, isRoundingInteger);
+	params->loadInstance(coordX, coordY, serviceTime, demands, vehicleCapacity, durationLimit, nbVeh, isDurationConstraint, true, &newIndex);
+	isInstanceLoaded = true;
+
+	params->deadline.stopRequest = stopRequest;
+	params->onNewBestSolution = nullptr;
+	params->resetSearch();
+	prepareSearchStructures();
+	genetic->reoptimization.run(genetic->offspring, previousRoutes, newIndex);
+	return &genetic->offspring;
+}
+
+void Solver::setSearchControl(const std::atomic <bool> * stopRequest, std::function <void(double, double)> onNewBestSolution)
+{
+	this->stopRequest = stopRequest;
+	this->onNewBestSolution = onNewBestSolution;
+}
+
+void Solver::setSearchLimits(int seed, int nbIter, double timeLimit)
+{
+	ap.seed = seed;
+	ap.nbIter = nbIter;
+	ap.timeLimit = timeLimit;
+	if (params)
+	{
+		params->ap.seed = seed;
+		params->ap.nbIter = nbIter;
+		params->ap.timeLimit = timeLimit;
+	}
+}
+
+const Individual * Solver::solve()
+{
+	if (!isInstanceLoaded) throw std::string("No instance has been loaded in the solver");
+	islandModel.reset();
+	params->deadline.stopRequest = stopRequest;
+	params->onNewBestSolution = onNewBestSolution;
+	params->resetSearch();
+	if (ap.nbThreads > 1 && ap.parallelScheme == 0)
+	{
+		islandModel.reset(new IslandModel(*params));
+		islandModel->run();
+		lastSolveTime = params->deadline.getElapsedTime();
+		return islandModel->getBestIsland().population.getBestFound();
+	}
+	prepareSearchStructures();
+	genetic->run();
+	lastSolveTime = params->deadline.getElapsedTime();
+	return genetic->population.getBestFound();
+}
+
+SolveStatistics Solver::getStatistics()
+{
+	SolveStatistics statistics = { lastSolveTime, 0, 0, {} };
+	if (islandModel)
+	{
+		for (std::unique_ptr <Genetic> & island : islandModel->islands)
+		{
+			statistics.nbIterations += island->nbOffspring;
+			statistics.nbLocalSearches += island->getNbLocalSearches();
+		}
+		statistics.searchProgress = islandModel->getBestIsland().population.getSearchProgress();
+	}
+	else if (genetic)
+	{
+		statistics.nbIterations = genetic->nbOffspring;
+		statistics.nbLocalSearches = genetic->getNbLocalSearches();
+		statistics.searchProgress = genetic->population.getSearchProgress();
+	}
+	return statistics;
+}
+
+const Individual * Solver::updateArcCosts(const std::vector < std::vector <int> > & routes, const std::vector <ArcCostUpdate> & updates)
+{
+	if (!isInstanceLoaded) throw std::string("No instance has been loaded in the solver");
+	islandModel.reset();
+	params->deadline.stopRequest = stopRequest;
+	params->onNewBestSolution = nullptr;
+	params->resetSearch();
+	prepareSearchStructures();
+	sameIndex.resize(params->nbClients + 1);
+	for (int i = 0; i <= params->nbClients; i++) sameIndex[i] = i;
+	genetic->reoptimization.run(genetic->offspring, routes, sameIndex);
+	genetic->reoptimization.updateArcCosts(genetic->offspring, updates);
+	return &genetic->offspring;
+}
+
+Solver::Solver(const AlgorithmParameters & ap, bool verbose) : ap(ap), verbose(verbose), isInstanceLoaded(false), nbClientsGenetic(0), nbVehiclesGenetic(0), stopRequest(nullptr), lastSolveTime(0.)
+{
+}
@@ -0,0 +1,91 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "Genetic.h"
+#include "IslandModel.h"
+#include <memory>
+
+// Statistics of the last solve of a solver
+struct SolveStatistics
+{
+	double time;								// Wall-clock time of the search in seconds
+	long long nbIterations;						// Number of iterations (offspring generated by crossover), over all threads
+	long long nbLocalSearches;					// Number of local searches (construction of the populations, offspring and repairs), over all threads
+	std::vector <SearchState> searchProgress;	// Successive best solutions of the search (of the best island in the island model)
+};
+
+// Solver kept alive between successive solves (handle of the C interface), such that the setup of the search is not repeated for each instance
+// The distance matrix and the data of the instance reuse their memory for instances of any size, and the neighbor lists are only recomputed when the distances change
+// The search structures (local search and its insertion tables, split, population, worker threads of the shared population mode) are kept as long as the numbers of clients and vehicles do not change
+// The island model is rebuilt at each solve, since each island owns a copy of the parameters
+class Solver
+{
+private:
+
+	AlgorithmParameters ap;									// Parameters of the algorithm, common to all instances
+	bool verbose;											// Controls the traces of the searches
+	DistanceMatrix distanceMatrix;							// Distance matrix of the current instance (referenced by params), owned or borrowed from the caller
+	std::vector <double> coordX;							// X coordinates of the current instance (empty if not provided)
+	std::vector <double> coordY;							// Y coordinates of the current instance (empty if not provided)
+	std::vector <double> serviceTime;						// Service durations of the current instance
+	std::vector <double> demands;							// Demands of the current instance
+	std::unique_ptr <Params> params;						// Parameters and data of the current instance (NULL before the first instance)
+	bool isInstanceLoaded;									// Tells if the current instance has been loaded successfully
+	std::unique_ptr <Genetic> genetic;						// Search structures of the sequential and shared population modes (NULL if not built yet)
+	int nbClientsGenetic;									// Number of clients for which these structures have been built
+	int nbVehiclesGenetic;									// Number of vehicles for which these structures have been built
+	std::unique_ptr <IslandModel> islandModel;				// Islands of the last solve with the island model, owning its best solution
+	std::vector <int> sameIndex;							// Identity mapping of the clients, used to load a solution of the current instance
+	const std::atomic <bool> * stopRequest;					// Flag ending the searches as soon as it is set (NULL if not used)
+	std::function <void(double, double)> onNewBestSolution;	// Observer of the new best solutions of the searches (empty if not used)
+	double lastSolveTime;									// Wall-clock time of the last solve in seconds
+
+	// Copies the data of a new instance and fills the distance matrix (see setInstance), and tells if the distances have changed since the previous instance
+	bool loadData(int n, const double * x, const double * y, const double * dist_mtx, int stride, bool isBorrowed, const double * serv_time, const double * dem, bool isRoundingInteger);
+
+	// Builds the search structures if the numbers of clients and vehicles have changed since they were built
+	void prepareSearchStructures();
+
+public:
+
+	// Loads a new instance (n nodes including the depot at index 0)
+	// The distances are read from the matrix dist_mtx if it is not NULL (row i starting at dist_mtx + i * stride), or computed from the coordinates otherwise (rounded to the nearest integer if isRoundingInteger)
+	// If isBorrowed, dist_mtx is used without any copy, and should remain valid and unchanged until the next instance is loaded or the solver is destroyed (the neighbor lists are then always recomputed)
+	// The coordinates x and y may be NULL if dist_mtx is given. nbVeh is INT_MAX if the fleet size is not limited
+	void setInstance(int n, const double * x, const double * y, const double * dist_mtx, int stride, bool isBorrowed, const double * serv_time, const double * dem,
+		double vehicleCapacity, double durationLimit, bool isRoundingInteger, bool isDurationConstraint, int nbVeh);
+
+	// Runs HGS on the current instance, and returns its best solution (NULL if none), valid until the next call to the solver
+	const Individual * solve();
+
+	// Modifies some arc costs of the current instance (the change persists for the next solves), and updates a solution of this instance (given by its routes) with a focused local search
+	// Returns the updated solution, valid until the next call to the solver
+	const Individual * updateArcCosts(const std::vector < std::vector <int> > & routes, const std::vector <ArcCostUpdate> & updates);
+
+	// Loads a modification of the current instance after a change of the set of clients (with the arguments of setInstance, the matrix being copied), and updates a solution of the current instance (given by its routes) into a solution of the new one
+	// The new instance contains the clients of the current one which are not in removedClients, in the same order, followed by the added clients, and the distances between the kept clients should be unchanged
+	// The neighbor lists of the current instance are updated rather than recomputed (see Params::remapNeighborLists). Returns the updated solution, valid until the next call to the solver
+	const Individual * reoptimize(int n, const double * x, const double * y, const double * dist_mtx, const double * serv_time, const double * dem,
+		double vehicleCapacity, double durationLimit, bool isRoundingInteger, bool isDurationConstraint, int nbVeh,
+		const std::vector < std::vector <int> > & previousRoutes, const std::vector <int> & removedClients);
+
+	// Sets a flag which ends the next searches as soon as it is set (returning their best solution), and an observer of their new best solutions (see Params::onNewBestSolution)
+	void setSearchControl(const std::atomic <bool> * stopRequest, std::function <void(double, double)> onNewBestSolution);
+
+	// Changes the seed, the number of iterations without improvement and the time limit of the next searches (the other parameters are fixed for the lifetime of the solver)
+	void setSearchLimits(int seed, int nbIter, double timeLimit);
+
+	// Statistics of the last solve
+	SolveStatistics getStatistics();
+
+	// Tells if the traces of the searches are written
+	bool isVerbose() const { return verbose; }
+
+	// Parameters of the current instance (NULL before the first instance)
+	Params * getParams() { return params.get(); }
+
+	// Constructor
+	Solver(const AlgorithmParameters & ap, bool verbose);
+};
+
+#endif
@@ -63,7 +63,7 @@ int Split::splitSimple(Individual & indiv)
 	}
 	else
 	{
-		Trivial_Deque queue = Trivial_Deque(params.nbClients + 1, 0);
+		queue.reset(0);
 		for (int i = 1; i <= params.nbClients; i++)
 		{
 			// The front is the best predecessor for i
@@ -90,17 +90,19 @@ int Split::splitSimple(Individual & indiv)
 	if (potential[0][params.nbClients] > 1.e29)
 		throw std::string("ERROR : no Split solution has been propagated until the last node");
 
-	// Filling the chromR structure
+	// Filling the route structure (each route is a segment of the giant tour)
 	for (int k = params.nbVehicles - 1; k >= maxVehicles; k--)
-		indiv.chromR[k].clear();
+	{
+		indiv.routeOffset[k] = params.nbClients;
+		indiv.routeLength[k] = 0;
+	}
 
 	int end = params.nbClients;
 	for (int k = maxVehicles - 1; k >= 0; k--)
 	{
-		indiv.chromR[k].clear();
 		int begin = pred[0][end];
-		for (int ii = begin; ii < end; ii++)
-			indiv.chromR[k].push_back(indiv.chromT[ii]);
+		indiv.routeOffset[k] = begin;
+		indiv.routeLength[k] = end - begin;
 		end = begin;
 	}
 
@@ -148,7 +150,6 @@ int Split::splitLF(Individual & indiv)
 	}
 	else // MAIN ALGORITHM -- Without duration constraints in O(n), from "Vidal, T. (2016). Split algorithm in O(n) for the capacitated vehicle routing problem. C&OR"
 	{
-		Trivial_Deque queue = Trivial_Deque(params.nbClients + 1, 0);
 		for (int k = 0; k < maxVehicles; k++)
 		{
 			// in the Split problem there is always one feasible solution with k routes that reaches the index k in the tour.
@@ -191,17 +192,19 @@ int Split::splitLF(Individual & indiv)
 		if (potential[k][params.nbClients] < minCost)
 			{minCost = potential[k][params.nbClients]; nbRoutes = k;}
 
-	// Filling the chromR structure
+	// Filling the route structure (each route is a segment of the giant tour)
 	for (int k = params.nbVehicles-1; k >= nbRoutes ; k--)
-		indiv.chromR[k].clear();
+	{
+		indiv.routeOffset[k] = params.nbClients;
+		indiv.routeLength[k] = 0;
+	}
 
 	int end = params.nbClients;
 	for (int k = nbRoutes - 1; k >= 0; k--)
 	{
-		indiv.chromR[k].clear();
 		int begin = pred[k+1][end];
-		for (int ii = begin; ii < end; ii++)
-			indiv.chromR[k].push_back(indiv.chromT[ii]);
+		indiv.routeOffset[k] = begin;
+		indiv.routeLength[k] = end - begin;
 		end = begin;
 	}
 
@@ -209,7 +212,7 @@ int Split::splitLF(Individual & indiv)
 	return (end == 0);
 }
 
-Split::Split(const Params & params): params(params)
+Split::Split(const Params & params): params(params), queue(params.nbClients + 1, 0)
 {
 	// Structures of the linear Split
 	cliSplit = std::vector <ClientSplit>(params.nbClients + 1);
@@ -76,6 +76,7 @@ class Split
  std::vector <double> sumDistance; // sumDistance[i] for i > 1 contains the sum of distances : sum_{k=1}^{i-1} d_{k,k+1}
  std::vector <double> sumLoad; // sumLoad[i] for i >= 1 contains the sum of loads : sum_{k=1}^{i} q_k
  std::vector <double> sumService; // sumService[i] for i >= 1 contains the sum of service time : sum_{k=1}^{i} s_k
+ Trivial_Deque queue; // Deque of the linear Split algorithms (allocated once)
 
  // To be called with i < j only
  // Computes the cost of propagating the label i until j
@@ -0,0 +1,68 @@
+#include "ThreadPool.h"
+
+void ThreadPool::work(int threadIndex)
+{
+	for (int i = nextTask++; i < nbTasks; i = nextTask++)
+	{
+		try { (*task)(i, threadIndex); }
+		catch (...)
+		{
+			std::lock_guard <std::mutex> lock(mutex);
+			if (!exception) exception = std::current_exception();
+		}
+	}
+}
+
+void ThreadPool::threadLoop(int threadIndex)
+{
+	long long lastLoopID = 0;
+	while (true)
+	{
+		{
+			std::unique_lock <std::mutex> lock(mutex);
+			wakeUp.wait(lock, [&] { return isTerminating || loopID != lastLoopID; });
+			if (isTerminating) return;
+			lastLoopID = loopID;
+		}
+		work(threadIndex);
+		{
+			std::lock_guard <std::mutex> lock(mutex);
+			nbBusyThreads--;
+		}
+		done.notify_one();
+	}
+}
+
+void ThreadPool::parallelFor(int nbTasks, const std::function<void(int, int)> & task)
+{
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		this->task = &task;
+		this->nbTasks = nbTasks;
+		nextTask = 0;
+		nbBusyThreads = (int)threads.size();
+		exception = nullptr;
+		loopID++;
+	}
+	wakeUp.notify_all();
+	work(0);
+	std::unique_lock <std::mutex> lock(mutex);
+	done.wait(lock, [&] { return nbBusyThreads == 0; });
+	if (exception) std::rethrow_exception(exception);
+}
+
+ThreadPool::ThreadPool(int nbThreads) : task(nullptr), nbTasks(0), nextTask(0), nbBusyThreads(0), loopID(0), isTerminating(false)
+{
+	for (int i = 1; i < nbThreads; i++)
+		threads.emplace_back(&ThreadPool::threadLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		isTerminating = true;
+	}
+	wakeUp.notify_all();
+	for (std::thread & thread : threads) thread.join();
+}
@@ -0,0 +1,52 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+// Simple pool of persistent threads used by the parallel modes of the algorithm
+// The calling thread takes part in the work, such that a pool of size N only creates N-1 additional threads
+class ThreadPool
+{
+private:
+
+	std::vector <std::thread> threads;					// Background threads (the calling thread is the thread of index 0)
+	std::mutex mutex;									// Protects the fields below
+	std::condition_variable wakeUp;						// Signals a new parallel loop (or the termination) to the background threads
+	std::condition_variable done;						// Signals the end of the current parallel loop to the calling thread
+	const std::function<void(int, int)> * task;		// Task of the current parallel loop
+	int nbTasks;										// Number of tasks of the current parallel loop
+	std::atomic <int> nextTask;							// Index of the next task to be picked
+	int nbBusyThreads;									// Number of background threads still working on the current parallel loop
+	long long loopID;									// Counter of parallel loops, used to wake up the background threads
+	bool isTerminating;									// Tells the background threads to stop
+	std::exception_ptr exception;						// First exception raised by a task in the current parallel loop
+
+	// Executes tasks of the current parallel loop until there is none left
+	void work(int threadIndex);
+
+	// Main function of the background threads
+	void threadLoop(int threadIndex);
+
+public:
+
+	// Executes task(i, threadIndex) for all i in [0, nbTasks) and returns once all tasks are completed
+	// Tasks are dynamically distributed over the threads, and threadIndex in [0, size()) identifies the thread running the task
+	void parallelFor(int nbTasks, const std::function<void(int, int)> & task);
+
+	// Number of threads, including the calling thread
+	int size() const { return (int)threads.size() + 1; }
+
+	// Constructor
+	ThreadPool(int nbThreads);
+
+	// Destructor
+	~ThreadPool();
+};
+
+#endif
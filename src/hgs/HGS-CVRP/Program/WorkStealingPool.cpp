@@ -0,0 +1,85 @@
+#include "WorkStealingPool.h"
+
+// Pool and index of the pool thread running the current thread (NULL and -1 outside of the pools)
+static thread_local WorkStealingPool * currentPool = nullptr;
+static thread_local int currentThreadIndex = -1;
+
+bool WorkStealingPool::takeTask(int threadIndex, std::function<void()> & task)
+{
+	int nbQueues = (int)queues.size();
+	for (int k = 0; k < nbQueues; k++)
+	{
+		TaskQueue & queue = *queues[(threadIndex + k) % nbQueues];
+		std::lock_guard <std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty()) continue;
+		if (k == 0) // Most recent task of its own queue
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else // Oldest task of another queue
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+		return true;
+	}
+	return false;
+}
+
+void WorkStealingPool::threadLoop(int threadIndex)
+{
+	currentPool = this;
+	currentThreadIndex = threadIndex;
+	std::function<void()> task;
+	while (true)
+	{
+		{
+			std::unique_lock <std::mutex> lock(mutex);
+			wakeUp.wait(lock, [&] { return isTerminating || nbQueuedTasks > 0; });
+			if (nbQueuedTasks == 0) return; // Terminating, and no task left
+			nbQueuedTasks--; // This thread will take one of the queued tasks
+		}
+		while (!takeTask(threadIndex, task)) std::this_thread::yield(); // The task may still be on its way to its queue
+		task();
+		task = nullptr;
+	}
+}
+
+void WorkStealingPool::submit(std::function<void()> task)
+{
+	int queueIndex;
+	if (currentPool == this) queueIndex = currentThreadIndex;
+	else
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		queueIndex = nextQueue;
+		nextQueue = (nextQueue + 1) % (int)queues.size();
+	}
+	{
+		std::lock_guard <std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->tasks.push_back(std::move(task));
+	}
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		nbQueuedTasks++;
+	}
+	wakeUp.notify_one();
+}
+
+WorkStealingPool::WorkStealingPool(int nbThreads) : nbQueuedTasks(0), nextQueue(0), isTerminating(false)
+{
+	nbThreads = std::max<int>(1, nbThreads);
+	for (int i = 0; i < nbThreads; i++) queues.emplace_back(new TaskQueue);
+	for (int i = 0; i < nbThreads; i++) threads.emplace_back(&WorkStealingPool::threadLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		isTerminating = true;
+	}
+	wakeUp.notify_all();
+	for (std::thread & thread : threads) thread.join();
+}
@@ -0,0 +1,56 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+// Pool of threads running independent tasks, used to share the cores between many concurrent solves (asynchronous solves of the C interface)
+// Each thread has its own queue: a task submitted by a thread of the pool goes to the queue of this thread, and the other tasks are distributed over the queues in turn
+// A thread runs the most recent task of its own queue, or steals the oldest task of another queue when its queue is empty
+// Unlike ThreadPool, which runs the parallel loops of one search, the tasks are not waited for by the pool: each task signals its own completion
+class WorkStealingPool
+{
+private:
+
+	struct TaskQueue
+	{
+		std::mutex mutex;								// Protects the tasks
+		std::deque < std::function<void()> > tasks;		// Tasks waiting in this queue
+	};
+
+	std::vector < std::unique_ptr <TaskQueue> > queues;	// Queue of each thread
+	std::vector <std::thread> threads;					// Threads of the pool
+	std::mutex mutex;									// Protects the fields below, and the sleep of the idle threads
+	std::condition_variable wakeUp;						// Signals a new task (or the termination) to the idle threads
+	int nbQueuedTasks;									// Number of tasks waiting in the queues
+	int nextQueue;										// Queue receiving the next task submitted from outside the pool
+	bool isTerminating;									// Tells the threads to stop once the queues are empty
+
+	// Takes a task from the queue of the thread, or from another queue, and returns false if all queues are empty
+	bool takeTask(int threadIndex, std::function<void()> & task);
+
+	// Main function of the threads
+	void threadLoop(int threadIndex);
+
+public:
+
+	// Queues a task, which will be run by one of the threads
+	void submit(std::function<void()> task);
+
+	// Number of threads
+	int size() const { return (int)threads.size(); }
+
+	// Constructor: starts nbThreads threads (at least one)
+	WorkStealingPool(int nbThreads);
+
+	// Destructor: runs the remaining tasks, and stops the threads
+	~WorkStealingPool();
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef WORKER_H
+#define WORKER_H
+
+#include "LocalSearch.h"
+#include "Split.h"
+#include "Crossover.h"
+
+// Search components owned by one thread in the parallel modes of the algorithm
+// Each worker has its own copy of the parameters: random number generator, penalty coefficients (copied from the master parameters before each use) and granular neighborhoods (which are shuffled by the local search)
+struct Worker
+{
+	Params params;					// Parameters of this worker
+	Split split;					// Split algorithm
+	LocalSearch localSearch;		// Local search structure
+	Reoptimization reoptimization;	// Cheapest insertions used by the route-based crossover
+	Crossover crossover;			// Crossover operators
+
+	// Constructor: the random number generator of the worker is seeded from (seed, index)
+	Worker(const Params & masterParams, int index) : params(masterParams), split(params), localSearch(params), reoptimization(params, localSearch), crossover(params, split, reoptimization)
+	{
+		std::seed_seq seedSequence{ masterParams.ap.seed, index };
+		params.ran.seed(seedSequence);
+		params.verbose = false;
+	}
+};
+
+#endif
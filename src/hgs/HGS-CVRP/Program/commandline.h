@@ -36,13 +36,22 @@ public:
 	int nbVeh		 = INT_MAX;		// Number of vehicles. Default value: infinity
 	std::string pathInstance;		// Instance path
 	std::string pathSolution;		// Solution path
+	std::string pathCheckpoint;		// Path of the snapshot file written periodically (empty if not requested)
+	std::string pathResume;			// Path of a snapshot file from which the search is resumed (empty for a new search)
+	double checkpointInterval = 600;	// Wall-clock time between two snapshots in seconds
+	std::string daemonEndpoint;		// Daemon mode: "stdin" or the path of a Unix domain socket (empty if not in daemon mode)
+	int nbWorkers = 0;				// Daemon and batch modes: number of requests or runs solved in parallel (0 for the number of hardware threads)
+	int cacheSize = 8;				// Daemon mode: number of idle solvers kept between the requests
+	int nbSeeds = 1;				// Batch mode: number of runs of each instance, with consecutive seeds
+	std::string pathBaseline;		// Benchmark: summary of a previous benchmark to compare with (empty if none)
+	double tolerance = 10;			// Benchmark: loss of throughput (in percent) beyond which the comparison with the baseline fails
 	bool verbose     = true;
 	bool isRoundingInteger = true;
 
 	// Reads the line of command and extracts possible options
 	CommandLine(int argc, char* argv[])
 	{
-		if (argc % 2 != 1 || argc > 35 || argc < 3)
+		if (argc % 2 != 1 || argc > 63 || argc < 3)
 		{
 			std::cout << "----- NUMBER OF COMMANDLINE ARGUMENTS IS INCORRECT: " << argc << std::endl;
 			display_help(); throw std::string("Incorrect line of command");
@@ -51,6 +60,13 @@ public:
 		{
 			pathInstance = std::string(argv[1]);
 			pathSolution = std::string(argv[2]);
+			if (pathInstance == "-daemon")
+			{
+				// Daemon mode: the requests carry the instances, and the other options give the default parameters
+				daemonEndpoint = pathSolution;
+				pathInstance.clear();
+				pathSolution.clear();
+			}
 			for (int i = 3; i < argc; i += 2)
 			{
 				if (std::string(argv[i]) == "-t")
@@ -85,6 +101,44 @@ public:
 					ap.penaltyIncrease = atof(argv[i+1]);
 				else if (std::string(argv[i]) == "-penaltyDecrease")
 					ap.penaltyDecrease = atof(argv[i+1]);
+				else if (std::string(argv[i]) == "-threads")
+					ap.nbThreads = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-parallelScheme")
+					ap.parallelScheme = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-migrationInterval")
+					ap.migrationInterval = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-migrationTopology")
+					ap.migrationTopology = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-timeLimitConstruction")
+					ap.timeLimitConstruction = atof(argv[i+1]);
+				else if (std::string(argv[i]) == "-nbEliteRestart")
+					ap.nbEliteRestart = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-crossover")
+					ap.crossoverType = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-sweepFraction")
+					ap.sweepFraction = atof(argv[i+1]);
+				else if (std::string(argv[i]) == "-adaptiveMoveOrder")
+					ap.adaptiveMoveOrder = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-gap")
+					ap.gap = atof(argv[i+1]);
+				else if (std::string(argv[i]) == "-deterministic")
+					ap.deterministic = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-checkpoint")
+					pathCheckpoint = std::string(argv[i+1]);
+				else if (std::string(argv[i]) == "-checkpointInterval")
+					checkpointInterval = atof(argv[i+1]);
+				else if (std::string(argv[i]) == "-resume")
+					pathResume = std::string(argv[i+1]);
+				else if (std::string(argv[i]) == "-workers")
+					nbWorkers = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-cacheSize")
+					cacheSize = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-seeds")
+					nbSeeds = atoi(argv[i+1]);
+				else if (std::string(argv[i]) == "-baseline")
+					pathBaseline = std::string(argv[i+1]);
+				else if (std::string(argv[i]) == "-tolerance")
+					tolerance = atof(argv[i+1]);
 				else
 				{
 					std::cout << "----- ARGUMENT NOT RECOGNIZED: " << std::string(argv[i]) << std::endl;
@@ -99,7 +153,7 @@ public:
 	{
 		std::cout << std::endl;
 		std::cout << "-------------------------------------------------- HGS-CVRP algorithm (2020) ---------------------------------------------------" << std::endl;
-		std::cout << "Call with: ./hgs instancePath solPath [-it nbIter] [-t myCPUtime] [-seed mySeed] [-veh nbVehicles] [-log verbose]               " << std::endl;
+		std::cout << "Call with: ./hgs instancePath solPath [-it nbIter] [-t myTimeLimit] [-seed mySeed] [-veh nbVehicles] [-log verbose]               " << std::endl;
 		std::cout << "[-it <int>] sets a maximum number of iterations without improvement. Defaults to 20,000                                         " << std::endl;
 		std::cout << "[-t <double>] sets a time limit in seconds. If this parameter is set the code will be run iteratively until the time limit      " << std::endl;
 		std::cout << "[-seed <int>] sets a fixed seed. Defaults to 0                                                                                  " << std::endl;
@@ -118,6 +172,33 @@ public:
 		std::cout << "[-targetFeasible <double>] target ratio of feasible individuals between penalty updates. Defaults to 0.2                        " << std::endl;
 		std::cout << "[-penaltyIncrease <double>] penalty increase if insufficient feasible individuals between penalty updates. Defaults to 1.2      " << std::endl;
 		std::cout << "[-penaltyDecrease <double>] penalty decrease if sufficient feasible individuals between penalty updates. Defaults to 0.85       " << std::endl;
+		std::cout << "[-threads <int>] Number of threads. Defaults to 1                                                                              " << std::endl;
+		std::cout << "[-parallelScheme <int>] Use of the threads. It can be 0 (island model) or 1 (shared population). Defaults to 0                 " << std::endl;
+		std::cout << "[-migrationInterval <int>] Number of iterations between migrations of elite individuals between islands. Defaults to 500     " << std::endl;
+		std::cout << "[-migrationTopology <int>] Destination of the migrants. It can be 0 (ring: next island) or 1 (random island). Defaults to 0    " << std::endl;
+		std::cout << "[-timeLimitConstruction <double>] Time limit in seconds for building each population, within the time limit. Defaults to 0 (none)" << std::endl;
+		std::cout << "[-nbEliteRestart <int>] Number of elite solutions kept across restarts (0 = complete regeneration). Defaults to 4              " << std::endl;
+		std::cout << "[-crossover <int>] Crossover operator. It can be 0 (OX on giant tours) or 1 (SREX: selective route exchange). Defaults to 0    " << std::endl;
+		std::cout << "[-sweepFraction <double>] Fraction of the initial individuals built by a sweep around the depot. Defaults to 0.25             " << std::endl;
+		std::cout << "[-adaptiveMoveOrder <bool>] Orders the local search moves by their observed gain per nanosecond. Defaults to 0 (fixed order)" << std::endl;
+		std::cout << "[-gap <double>] Stops once the best solution is within this percentage of a lower bound. Defaults to 0 (inactive)           " << std::endl;
+		std::cout << "[-deterministic <bool>] Reproducible parallel modes (same seed and threads give the same solution without -t). Defaults to 0 " << std::endl;
+		std::cout << "[-checkpoint <path>] Writes periodic snapshots of the search in this file, and a last one when interrupted by SIGINT/SIGTERM   " << std::endl;
+		std::cout << "[-checkpointInterval <double>] Wall-clock time in seconds between two snapshots. Defaults to 600                                " << std::endl;
+		std::cout << "[-resume <path>] Resumes the search from a snapshot file (same instance and parameters)                                         " << std::endl;
+		std::cout << std::endl;
+		std::cout << "Daemon mode: ./hgs -daemon <stdin|socketPath> [options] solves NDJSON requests read from stdin (or a Unix domain socket)          " << std::endl;
+		std::cout << "[-workers <int>] Number of requests solved in parallel. Defaults to the number of hardware threads                             " << std::endl;
+		std::cout << "[-cacheSize <int>] Number of idle solvers kept between the requests, to reuse their structures. Defaults to 8                  " << std::endl;
+		std::cout << std::endl;
+		std::cout << "Batch mode: ./hgs_batch <instanceDirectory|manifest> <results.csv|results.json> [options] solves all instances in one process  " << std::endl;
+		std::cout << "[-seeds <int>] Number of runs of each instance, with the seeds following -seed. Defaults to 1                                 " << std::endl;
+		std::cout << "[-workers <int>] Number of runs solved in parallel. Defaults to the number of hardware threads                                 " << std::endl;
+		std::cout << std::endl;
+		std::cout << "Benchmark: ./hgs_bench <manifest> <summary.json> [options] reports the gaps to the BKS, times to target and throughput          " << std::endl;
+		std::cout << "[-baseline <path>] Compares the throughput with the summary of a previous benchmark, and fails in case of regression        " << std::endl;
+		std::cout << "[-tolerance <double>] Loss of throughput in percent accepted by the comparison with the baseline. Defaults to 10             " << std::endl;
+		std::cout << "[-seeds <int>] and [-workers <int>] as in the batch mode, the runs being solved one at a time by default                     " << std::endl;
 		std::cout << "--------------------------------------------------------------------------------------------------------------------------------" << std::endl;
 		std::cout << std::endl;
 	};
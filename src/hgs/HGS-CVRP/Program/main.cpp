@@ -1,8 +1,11 @@
 #include "Genetic.h"
+#include "IslandModel.h"
+#include "Checkpoint.h"
 #include "commandline.h"
 #include "LocalSearch.h"
 #include "Split.h"
 #include "InstanceCVRPLIB.h"
+#include "Daemon.h"
 using namespace std;
 
 int main(int argc, char *argv[])
@@ -12,6 +15,14 @@ int main(int argc, char *argv[])
 		// Reading the arguments of the program
 		CommandLine commandline(argc, argv);
 
+		// Daemon mode: serving the requests of a pipeline until the end of the input or a shutdown request
+		if (!commandline.daemonEndpoint.empty())
+		{
+			Daemon daemon(commandline.ap, commandline.nbVeh, commandline.isRoundingInteger, commandline.nbWorkers, commandline.cacheSize);
+			daemon.run(commandline.daemonEndpoint);
+			return 0;
+		}
+
 		// Print all algorithm parameter values
 		if (commandline.verbose) print_algorithm_parameters(commandline.ap);
 
@@ -22,16 +33,37 @@ int main(int argc, char *argv[])
 		Params params(cvrp.x_coords,cvrp.y_coords,cvrp.dist_mtx,cvrp.service_time,cvrp.demands,
 			          cvrp.vehicleCapacity,cvrp.durationLimit,commandline.nbVeh,cvrp.isDurationConstraint,commandline.verbose,commandline.ap);
 
-		// Running HGS
-		Genetic solver(params);
-		solver.run();
+		// Running HGS (with the island model or a shared population if several threads are requested)
+		std::unique_ptr<Genetic> solver;
+		std::unique_ptr<IslandModel> islandModel;
+		std::unique_ptr<Checkpoint> checkpoint;
+		if (params.ap.nbThreads > 1 && params.ap.parallelScheme == 0)
+		{
+			if (!commandline.pathCheckpoint.empty() || !commandline.pathResume.empty()) throw std::string("Snapshots are not available with the island model");
+			islandModel.reset(new IslandModel(params));
+			islandModel->run();
+		}
+		else
+		{
+			solver.reset(new Genetic(params));
+			solver->pathResume = commandline.pathResume;
+			if (!commandline.pathCheckpoint.empty())
+			{
+				// Snapshots are written periodically, and when the program is interrupted
+				checkpoint.reset(new Checkpoint(commandline.pathCheckpoint, commandline.checkpointInterval));
+				Checkpoint::installSignalHandlers();
+				solver->checkpoint = checkpoint.get();
+			}
+			solver->run();
+		}
+		Population & population = (islandModel) ? islandModel->getBestIsland().population : solver->population;
 		
 		// Exporting the best solution
-		if (solver.population.getBestFound() != NULL)
+		if (population.getBestFound() != NULL)
 		{
 			if (params.verbose) std::cout << "----- WRITING BEST SOLUTION IN : " << commandline.pathSolution << std::endl;
-			solver.population.exportCVRPLibFormat(*solver.population.getBestFound(),commandline.pathSolution);
-			solver.population.exportSearchProgress(commandline.pathSolution + ".PG.csv", commandline.pathInstance);
+			population.exportCVRPLibFormat(*population.getBestFound(),commandline.pathSolution);
+			population.exportSearchProgress(commandline.pathSolution + ".PG.csv", commandline.pathInstance);
 		}
 	}
 	catch (const string& e) { std::cout << "EXCEPTION | " << e << std::endl; }
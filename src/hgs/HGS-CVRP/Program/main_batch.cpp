@@ -0,0 +1,20 @@
+#include "Batch.h"
+#include "commandline.h"
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+	try
+	{
+		// Reading the arguments of the program: directory or manifest of the instances, file of results, and options
+		CommandLine commandline(argc, argv);
+		if (commandline.verbose) print_algorithm_parameters(commandline.ap);
+
+		// Solving all runs in this process, and writing one row of results per run
+		Batch batch(commandline.ap, commandline.nbVeh, commandline.isRoundingInteger, commandline.verbose, commandline.nbWorkers);
+		batch.run(commandline.pathInstance, commandline.pathSolution, commandline.nbSeeds);
+	}
+	catch (const string& e) { std::cout << "EXCEPTION | " << e << std::endl; }
+	catch (const std::exception& e) { std::cout << "EXCEPTION | " << e.what() << std::endl; }
+	return 0;
+}
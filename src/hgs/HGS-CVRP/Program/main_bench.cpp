@@ -0,0 +1,30 @@
+#include "Benchmark.h"
+#include "commandline.h"
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+	try
+	{
+		// Reading the arguments of the program: manifest of the instances with their BKS values, file of the summary, and options
+		CommandLine commandline(argc, argv);
+		if (commandline.verbose) print_algorithm_parameters(commandline.ap);
+
+		// Solving all runs, one at a time unless requested otherwise, such that the throughput of a run is not affected by the others
+		int nbWorkers = (commandline.nbWorkers > 0) ? commandline.nbWorkers : 1;
+		Batch batch(commandline.ap, commandline.nbVeh, commandline.isRoundingInteger, commandline.verbose, nbWorkers);
+		batch.run(commandline.pathInstance, "", commandline.nbSeeds);
+
+		// Summary of the runs, and comparison with the baseline
+		Benchmark benchmark(batch.getResults());
+		benchmark.print();
+		std::ofstream summaryFile(commandline.pathSolution);
+		if (!summaryFile.is_open()) throw std::string("Impossible to open the summary file: " + commandline.pathSolution);
+		summaryFile << benchmark.serialize();
+		summaryFile.close();
+		if (!commandline.pathBaseline.empty() && !benchmark.compareWithBaseline(commandline.pathBaseline, commandline.tolerance)) return 1;
+	}
+	catch (const string& e) { std::cout << "EXCEPTION | " << e << std::endl; return 1; }
+	catch (const std::exception& e) { std::cout << "EXCEPTION | " << e.what() << std::endl; return 1; }
+	return 0;
+}
@@ -0,0 +1,304 @@
+// Python extension module "hgscvrp", built on the C interface of the shared library
+// The NumPy arrays of the caller are read in place when they already have the expected type and layout (float64, contiguous rows), and the distance matrix is borrowed by the solver without any copy
+// The GIL is released during the solves, such that several Python threads can solve in parallel (with one Solver each)
+// The routes are returned as NumPy views of the single allocation of the solution, released with the last of them
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+#include "C_Interface.h"
+#include "AlgorithmParameters.h"
+#include <climits>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+// Python object wrapping a solver handle
+struct SolverObject
+{
+	PyObject_HEAD
+	HGSSolver * solver;					// Solver handle of the C interface
+	std::mutex * mutex;					// Held during a solve: a handle is only used by one thread at a time
+	PyObject * borrowedMatrix;			// Distance matrix borrowed by the current instance of the solver (NULL if none)
+};
+
+// Raises the last error of the C interface in the calling thread as a Python exception
+static void raise_last_error()
+{
+	int code = hgs_last_error();
+	PyObject * type = (code == HGS_ERROR_OUT_OF_MEMORY) ? PyExc_MemoryError : (code == HGS_ERROR_INVALID_INPUT) ? PyExc_ValueError : PyExc_RuntimeError;
+	PyErr_SetString(type, hgs_last_error_message());
+}
+
+// Reads a dictionary of parameters, given by their names in AlgorithmParameters, over the default parameters. Returns false with a Python exception on error
+static bool read_parameters(PyObject * params, AlgorithmParameters & ap)
+{
+	ap = default_algorithm_parameters();
+	ap.nbIterTraces = INT_MAX; // No traces unless requested
+	if (params == nullptr || params == Py_None) return true;
+	if (!PyDict_Check(params)) { PyErr_SetString(PyExc_TypeError, "params should be a dict"); return false; }
+	PyObject * key;
+	PyObject * value;
+	Py_ssize_t position = 0;
+	while (PyDict_Next(params, &position, &key, &value))
+	{
+		const char * name = PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : nullptr;
+		const AlgorithmParameterField * field = (name != nullptr) ? find_algorithm_parameter(name) : nullptr;
+		if (field == nullptr) { PyErr_Format(PyExc_ValueError, "Unknown parameter: %S", key); return false; }
+		if (field->intField != nullptr)
+		{
+			long intValue = PyLong_AsLong(value);
+			if (intValue == -1 && PyErr_Occurred()) return false;
+			if (intValue < INT_MIN || intValue > INT_MAX) { PyErr_Format(PyExc_OverflowError, "Parameter %s is out of range", name); return false; }
+			ap.*(field->intField) = (int)intValue;
+		}
+		else
+		{
+			double doubleValue = PyFloat_AsDouble(value);
+			if (doubleValue == -1. && PyErr_Occurred()) return false;
+			ap.*(field->doubleField) = doubleValue;
+		}
+	}
+	return true;
+}
+
+// Vector of n values as a float64 array, without a copy if it is already a contiguous float64 array (new reference, NULL with a Python exception on error)
+static PyArrayObject * as_vector(PyObject * object, npy_intp n, const char * name)
+{
+	PyArrayObject * array = (PyArrayObject *)PyArray_FROMANY(object, NPY_DOUBLE, 1, 1, NPY_ARRAY_IN_ARRAY);
+	if (array == nullptr) return nullptr;
+	if (n >= 0 && PyArray_DIM(array, 0) != n)
+	{
+		PyErr_Format(PyExc_ValueError, "%s should have %zd values", name, (Py_ssize_t)n);
+		Py_DECREF(array);
+		return nullptr;
+	}
+	return array;
+}
+
+// Distance matrix of n x n values as a float64 array whose rows are contiguous, without a copy if the array already has this layout (new reference, NULL with a Python exception on error)
+static PyArrayObject * as_matrix(PyObject * object, npy_intp n)
+{
+	PyArrayObject * array = (PyArrayObject *)PyArray_FROMANY(object, NPY_DOUBLE, 2, 2, NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED);
+	if (array == nullptr) return nullptr;
+	if (PyArray_DIM(array, 0) != n || PyArray_DIM(array, 1) != n)
+	{
+		PyErr_Format(PyExc_ValueError, "distances should be a %zd x %zd matrix", (Py_ssize_t)n, (Py_ssize_t)n);
+		Py_DECREF(array);
+		return nullptr;
+	}
+	if (PyArray_STRIDE(array, 1) != sizeof(double) || PyArray_STRIDE(array, 0) < n * (npy_intp)sizeof(double) || PyArray_STRIDE(array, 0) % sizeof(double) != 0)
+	{
+		// Columns not contiguous (e.g., a transposed view): a contiguous copy is made
+		PyArrayObject * copy = (PyArrayObject *)PyArray_FROMANY((PyObject *)array, NPY_DOUBLE, 2, 2, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_ENSURECOPY);
+		Py_DECREF(array);
+		array = copy;
+	}
+	return array;
+}
+
+static void release_solution(PyObject * capsule)
+{
+	delete_solution((Solution *)PyCapsule_GetPointer(capsule, "hgscvrp.Solution"));
+}
+
+// Converts a solution into a dict {"cost", "time", "routes"}, the routes being int32 views of the nodes of the solution (takes ownership of the solution)
+static PyObject * convert_solution(Solution * sol)
+{
+	PyObject * capsule = PyCapsule_New(sol, "hgscvrp.Solution", release_solution);
+	if (capsule == nullptr) { delete_solution(sol); return nullptr; }
+	npy_intp nbNodes = sol->route_offsets[sol->n_routes];
+	PyObject * nodes = PyArray_SimpleNewFromData(1, &nbNodes, NPY_INT32, sol->nodes);
+	if (nodes == nullptr || PyArray_SetBaseObject((PyArrayObject *)nodes, capsule) < 0)
+	{
+		Py_XDECREF(nodes);
+		Py_DECREF(capsule);
+		return nullptr;
+	}
+	PyArray_CLEARFLAGS((PyArrayObject *)nodes, NPY_ARRAY_WRITEABLE);
+	PyObject * routes = PyList_New(sol->n_routes);
+	for (int r = 0; routes != nullptr && r < sol->n_routes; r++)
+	{
+		PyObject * route = PySequence_GetSlice(nodes, sol->route_offsets[r], sol->route_offsets[r + 1]);
+		if (route == nullptr) Py_CLEAR(routes);
+		else PyList_SET_ITEM(routes, r, route);
+	}
+	PyObject * result = (routes != nullptr) ? Py_BuildValue("{s:d,s:d,s:O}", "cost", sol->cost, "time", sol->time, "routes", routes) : nullptr;
+	Py_XDECREF(routes);
+	Py_DECREF(nodes);
+	return result;
+}
+
+static PyObject * Solver_new(PyTypeObject * type, PyObject * args, PyObject * kwargs)
+{
+	static const char * keywords[] = { "params", "verbose", nullptr };
+	PyObject * params = nullptr;
+	int verbose = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Op", (char **)keywords, &params, &verbose)) return nullptr;
+	AlgorithmParameters ap;
+	if (!read_parameters(params, ap)) return nullptr;
+	SolverObject * self = (SolverObject *)type->tp_alloc(type, 0);
+	if (self == nullptr) return nullptr;
+	self->solver = hgs_create(&ap, (char)verbose);
+	self->mutex = new std::mutex;
+	self->borrowedMatrix = nullptr;
+	if (self->solver == nullptr) { raise_last_error(); Py_DECREF(self); return nullptr; }
+	return (PyObject *)self;
+}
+
+static void Solver_dealloc(SolverObject * self)
+{
+	if (self->solver != nullptr) hgs_destroy(self->solver);
+	delete self->mutex;
+	Py_XDECREF(self->borrowedMatrix);
+	Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject * Solver_solve(SolverObject * self, PyObject * args, PyObject * kwargs)
+{
+	static const char * keywords[] = { "demands", "capacity", "x", "y", "distances", "service_times", "duration_limit", "vehicles", "round", nullptr };
+	PyObject * demandsObject;
+	double capacity;
+	PyObject * xObject = Py_None;
+	PyObject * yObject = Py_None;
+	PyObject * distancesObject = Py_None;
+	PyObject * serviceObject = Py_None;
+	PyObject * durationObject = Py_None;
+	PyObject * vehiclesObject = Py_None;
+	int isRoundingInteger = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Od|OOOOOOp", (char **)keywords, &demandsObject, &capacity,
+		&xObject, &yObject, &distancesObject, &serviceObject, &durationObject, &vehiclesObject, &isRoundingInteger)) return nullptr;
+
+	// Instance data, kept alive (and the caller's arrays unchanged) until the end of the call
+	PyArrayObject * demands = as_vector(demandsObject, -1, "demands");
+	if (demands == nullptr) return nullptr;
+	npy_intp n = PyArray_DIM(demands, 0);
+	PyArrayObject * x = nullptr;
+	PyArrayObject * y = nullptr;
+	PyArrayObject * distances = nullptr;
+	PyArrayObject * serviceTime = nullptr;
+	PyObject * result = nullptr;
+	double durationLimit = 1.e30;
+	int nbVehicles = INT_MAX;
+	std::vector <double> zeros;
+	Solution * sol = nullptr;
+	int status = HGS_OK;
+	if (n > INT_MAX) { PyErr_SetString(PyExc_ValueError, "The instance is too large"); goto cleanup; }
+	if ((xObject == Py_None) != (yObject == Py_None)) { PyErr_SetString(PyExc_ValueError, "Both coordinates x and y should be given"); goto cleanup; }
+	if (xObject != Py_None && ((x = as_vector(xObject, n, "x")) == nullptr || (y = as_vector(yObject, n, "y")) == nullptr)) goto cleanup;
+	if (distancesObject != Py_None && (distances = as_matrix(distancesObject, n)) == nullptr) goto cleanup;
+	if (serviceObject != Py_None && (serviceTime = as_vector(serviceObject, n, "service_times")) == nullptr) goto cleanup;
+	if (serviceObject == Py_None) zeros.assign(n, 0.);
+	if (durationObject != Py_None && (durationLimit = PyFloat_AsDouble(durationObject)) == -1. && PyErr_Occurred()) goto cleanup;
+	if (vehiclesObject != Py_None)
+	{
+		long value = PyLong_AsLong(vehiclesObject);
+		if (value == -1 && PyErr_Occurred()) goto cleanup;
+		nbVehicles = (int)std::max<long>(1, std::min<long>(value, INT_MAX));
+	}
+	if (!self->mutex->try_lock()) { PyErr_SetString(PyExc_RuntimeError, "The solver is already solving in another thread"); goto cleanup; }
+
+	{
+		double * xData = x ? (double *)PyArray_DATA(x) : nullptr;
+		double * yData = y ? (double *)PyArray_DATA(y) : nullptr;
+		double * serviceData = serviceTime ? (double *)PyArray_DATA(serviceTime) : zeros.data();
+		double * demandData = (double *)PyArray_DATA(demands);
+		char isDurationConstraint = (durationObject != Py_None);
+		Py_BEGIN_ALLOW_THREADS
+		if (distances != nullptr)
+			status = hgs_set_instance_view(self->solver, (int)n, xData, yData, (const double *)PyArray_DATA(distances), (int)(PyArray_STRIDE(distances, 0) / sizeof(double)),
+				serviceData, demandData, capacity, durationLimit, isDurationConstraint, nbVehicles);
+		else
+			status = hgs_set_instance(self->solver, (int)n, xData, yData, nullptr, serviceData, demandData, capacity, durationLimit, (char)isRoundingInteger, isDurationConstraint, nbVehicles);
+		if (status == HGS_OK) sol = hgs_solve(self->solver);
+		Py_END_ALLOW_THREADS
+	}
+
+	// The solver keeps a reference to the matrix it borrows, until the next instance
+	Py_XDECREF(self->borrowedMatrix);
+	self->borrowedMatrix = (PyObject *)distances;
+	distances = nullptr;
+	self->mutex->unlock();
+
+	if (status != HGS_OK || sol == nullptr) raise_last_error();
+	else result = convert_solution(sol);
+
+cleanup:
+	Py_DECREF(demands);
+	Py_XDECREF(x);
+	Py_XDECREF(y);
+	Py_XDECREF(distances);
+	Py_XDECREF(serviceTime);
+	return result;
+}
+
+static PyMethodDef Solver_methods[] =
+{
+	{ "solve", (PyCFunction)(void(*)(void))Solver_solve, METH_VARARGS | METH_KEYWORDS,
+		"solve(demands, capacity, x=None, y=None, distances=None, service_times=None, duration_limit=None, vehicles=None, round=True)\n"
+		"Solves an instance (node 0 is the depot) and returns a dict with the cost, the time and the routes (int32 arrays of clients).\n"
+		"The distances are read from the n x n matrix if given (borrowed until the next solve), or computed from the coordinates." },
+	{ nullptr, nullptr, 0, nullptr }
+};
+
+static PyTypeObject SolverType =
+{
+	PyVarObject_HEAD_INIT(nullptr, 0)
+	"hgscvrp.Solver",
+};
+
+// Solves an instance with a temporary solver
+static PyObject * module_solve(PyObject *, PyObject * args, PyObject * kwargs)
+{
+	PyObject * params = nullptr;
+	if (kwargs != nullptr)
+	{
+		params = PyDict_GetItemString(kwargs, "params");
+		Py_XINCREF(params);
+		if (params != nullptr) PyDict_DelItemString(kwargs, "params");
+	}
+	PyObject * solverArgs = Py_BuildValue("(O)", params ? params : Py_None);
+	Py_XDECREF(params);
+	if (solverArgs == nullptr) return nullptr;
+	PyObject * solver = Solver_new(&SolverType, solverArgs, nullptr);
+	Py_DECREF(solverArgs);
+	if (solver == nullptr) return nullptr;
+	PyObject * result = Solver_solve((SolverObject *)solver, args, kwargs);
+	Py_DECREF(solver);
+	return result;
+}
+
+static PyMethodDef module_methods[] =
+{
+	{ "solve", (PyCFunction)(void(*)(void))module_solve, METH_VARARGS | METH_KEYWORDS,
+		"solve(demands, capacity, x=None, y=None, distances=None, service_times=None, duration_limit=None, vehicles=None, round=True, params=None)\n"
+		"Solves an instance with a temporary Solver. params is a dict of AlgorithmParameters fields (e.g. {'timeLimit': 1, 'seed': 3})." },
+	{ nullptr, nullptr, 0, nullptr }
+};
+
+static PyModuleDef module =
+{
+	PyModuleDef_HEAD_INIT, "hgscvrp", "Hybrid Genetic Search for the CVRP", -1, module_methods
+};
+
+PyMODINIT_FUNC PyInit_hgscvrp()
+{
+	import_array();
+	SolverType.tp_basicsize = sizeof(SolverObject);
+	SolverType.tp_flags = Py_TPFLAGS_DEFAULT;
+	SolverType.tp_doc = "Solver(params=None, verbose=False)\nReusable solver, keeping its structures between the solves. params is a dict of AlgorithmParameters fields.";
+	SolverType.tp_new = Solver_new;
+	SolverType.tp_dealloc = (destructor)Solver_dealloc;
+	SolverType.tp_methods = Solver_methods;
+	if (PyType_Ready(&SolverType) < 0) return nullptr;
+	PyObject * m = PyModule_Create(&module);
+	if (m == nullptr) return nullptr;
+	Py_INCREF(&SolverType);
+	if (PyModule_AddObject(m, "Solver", (PyObject *)&SolverType) < 0)
+	{
+		Py_DECREF(&SolverType);
+		Py_DECREF(m);
+		return nullptr;
+	}
+	return m;
+}
@@ -0,0 +1,32 @@
+// Checks that the main loop of the genetic algorithm does not allocate memory once the population is built
+// The default configuration (OX crossover, sequential run) is checked, with the fixed and the adaptive order of the local search moves
+// The buffers of the route-based crossover grow with the routes, and are only amortized
+// The search progress log is reserved for SEARCH_PROGRESS_RESERVE best solutions, which the test also checks (it is only amortized beyond)
+#include "Genetic.h"
+#include "InstanceCVRPLIB.h"
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2) { std::cout << "Usage: lib_test_allocations instancePath" << std::endl; return 1; }
+	try
+	{
+		InstanceCVRPLIB cvrp(argv[1], true);
+		for (int adaptiveMoveOrder = 0; adaptiveMoveOrder <= 1; adaptiveMoveOrder++)
+		{
+			AlgorithmParameters ap = default_algorithm_parameters();
+			ap.nbIter = 3000;
+			ap.seed = 1;
+			ap.adaptiveMoveOrder = adaptiveMoveOrder;
+			Params params(cvrp.x_coords, cvrp.y_coords, cvrp.dist_mtx, cvrp.service_time, cvrp.demands,
+				cvrp.vehicleCapacity, cvrp.durationLimit, INT_MAX, cvrp.isDurationConstraint, false, ap);
+			Genetic solver(params);
+			solver.run();
+			std::cout << "HEAP ALLOCATIONS AFTER " << solver.nbIterWarmUp << " ITERATIONS (ADAPTIVE MOVE ORDER " << adaptiveMoveOrder << "): " << solver.nbAllocationsSteadyState << std::endl;
+			if (solver.nbAllocationsSteadyState != 0) return 1;
+			if (solver.population.getSearchProgress().size() > SEARCH_PROGRESS_RESERVE) { std::cout << "SEARCH PROGRESS BEYOND ITS RESERVED CAPACITY" << std::endl; return 1; }
+		}
+	}
+	catch (const std::string & e) { std::cout << "EXCEPTION | " << e << std::endl; return 1; }
+	return 0;
+}
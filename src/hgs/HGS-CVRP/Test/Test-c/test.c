@@ -30,6 +30,22 @@ void print_solution(struct Solution * sol) {
 		printf("\n");
 	}
 }
+// Progress of the asynchronous solves (read after hgs_job_wait)
+struct Progress
+{
+	int nbCalls;
+	double lastCost;
+};
+
+void record_progress(double cost, double time, void *userData)
+{
+	struct Progress *progress = (struct Progress *)userData;
+	assert(cost < progress->lastCost);
+	assert(time >= 0.);
+	progress->nbCalls++;
+	progress->lastCost = cost;
+}
+
 int main()
 {
 	// Preparing algorithm parameters
@@ -192,6 +208,248 @@ int main()
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	printf("-------- test.c #8 (island model) -----\n");
+
+	ap = default_algorithm_parameters();
+	ap.timeLimit = 1.73; // seconds
+	ap.nbIter = 10000; // iterations
+	ap.nbThreads = 2;
+	ap.migrationInterval = 100;
+	struct Solution *sol8 = solve_cvrp(
+		n, x, y, s, d,
+		v_cap, 100000000, isRoundingInteger, 0,
+		2, &ap, verbose);
+	print_solution(sol8);
+	assert(sol8->cost == 29);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #9 (shared population) -----\n");
+
+	ap = default_algorithm_parameters();
+	ap.timeLimit = 1.73; // seconds
+	ap.nbIter = 10000; // iterations
+	ap.nbThreads = 2;
+	ap.parallelScheme = 1;
+	struct Solution *sol9 = solve_cvrp(
+		n, x, y, s, d,
+		v_cap, 100000000, isRoundingInteger, 0,
+		2, &ap, verbose);
+	print_solution(sol9);
+	assert(sol9->cost == 29);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #10 (re-optimization after removing customer 3 and adding a new customer) -----\n");
+
+	ap = default_algorithm_parameters();
+	double x10[] = {1, 2, 4, 5, 6, 7, 8, 9, 10, 4.5};
+	double y10[] = {5, 4, 2, 1, 9, 8, 7, 6, 5, 2};
+	double s10[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+	double d10[] = {0, 2, 1, 2, 3, 1, 2, 3, 1, 2};
+	int removed10[] = {3};
+	struct Solution *sol10 = reoptimize_cvrp(
+		n, x10, y10, s10, d10,
+		v_cap, 100000000, isRoundingInteger, 0,
+		2, &ap, verbose,
+		n, sol, removed10, 1);
+	print_solution(sol10);
+	int visits10[10] = {0};
+	for (int i = 0; i < sol10->n_routes; i++)
+		for (int j = 0; j < sol10->routes[i].length; j++)
+			visits10[sol10->routes[i].path[j]]++;
+	for (int i = 1; i < n; i++)
+		assert(visits10[i] == 1);
+	assert(sol10->cost == 29);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #11 (re-optimization after an arc cost increase) -----\n");
+
+	ap = default_algorithm_parameters();
+	int arcFrom11[] = {sol2->routes[0].path[0]};
+	int arcTo11[] = {sol2->routes[0].path[1]};
+	double arcCost11[] = {100};
+	struct Solution *sol11 = reoptimize_cvrp_arc_costs(
+		n, x, y, (double*)dist_mtx, s, d,
+		v_cap, 100000000, 0,
+		2, &ap, verbose,
+		sol2, arcFrom11, arcTo11, arcCost11, 1);
+	print_solution(sol11);
+	int visits11[10] = {0};
+	for (int i = 0; i < sol11->n_routes; i++)
+	{
+		for (int j = 0; j < sol11->routes[i].length; j++)
+		{
+			visits11[sol11->routes[i].path[j]]++;
+			if (j > 0) assert(sol11->routes[i].path[j-1] != arcFrom11[0] || sol11->routes[i].path[j] != arcTo11[0]);
+		}
+	}
+	for (int i = 1; i < n; i++)
+		assert(visits11[i] == 1);
+	assert(sol11->cost < sol2->cost + 10);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #12 (solver handle reused for several instances) -----\n");
+
+	ap = default_algorithm_parameters();
+	ap.timeLimit = 1.73; // seconds
+	ap.nbIter = 10000; // iterations
+	struct HGSSolver *solver = hgs_create(&ap, verbose);
+	assert(solver != NULL);
+	int status = hgs_set_instance(solver, n, x, y, NULL, s, d, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Solution *sol12a = hgs_solve(solver);
+	print_solution(sol12a);
+	assert(sol12a->cost == 29);
+
+	// Same instance solved again, then the same distances with other demands (the neighbor lists are kept), then another distance matrix
+	struct Solution *sol12b = hgs_solve(solver);
+	assert(sol12b->cost == 29);
+	double d12[] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+	status = hgs_set_instance(solver, n, x, y, NULL, s, d12, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Solution *sol12c = hgs_solve(solver);
+	print_solution(sol12c);
+	assert(sol12c->cost <= 29);
+	status = hgs_set_instance(solver, n, NULL, NULL, (double*)dist_mtx, s, d, v_cap, 100000000, 0, 0, 2);
+	assert(status == 0);
+	struct Solution *sol12d = hgs_solve(solver);
+	print_solution(sol12d);
+	assert(round(sol12d->cost) == round(sol2->cost));
+
+	// Arc cost update of the current instance, then a smaller instance
+	struct Solution *sol12e = hgs_update_arc_costs(solver, sol12d, arcFrom11, arcTo11, arcCost11, 1);
+	assert(sol12e->cost < sol2->cost + 10);
+
+	// Invalid arc cost update (the second cost is negative): nothing is applied, and the same update is valid afterwards
+	int arcFrom12[] = {arcFrom11[0], 2};
+	int arcTo12[] = {arcTo11[0], 3};
+	double arcCost12[] = {arcCost11[0], -1.};
+	struct Solution *sol12eInvalid = hgs_update_arc_costs(solver, sol12e, arcFrom12, arcTo12, arcCost12, 2);
+	assert(sol12eInvalid == NULL);
+	assert(hgs_last_error() == HGS_ERROR_INVALID_INPUT);
+	struct Solution *sol12e2 = hgs_update_arc_costs(solver, sol12e, arcFrom11, arcTo11, arcCost11, 1);
+	assert(sol12e2->cost <= sol12e->cost + 0.001);
+	status = hgs_set_instance(solver, 9, x10, y10, NULL, s10, d10, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Solution *sol12f = hgs_solve(solver);
+	print_solution(sol12f);
+	int visits12[9] = {0};
+	for (int i = 0; i < sol12f->n_routes; i++)
+		for (int j = 0; j < sol12f->routes[i].length; j++)
+			visits12[sol12f->routes[i].path[j]]++;
+	for (int i = 1; i < 9; i++)
+		assert(visits12[i] == 1);
+
+	// Re-optimization of the handle after removing customer 3 and adding a new customer (as in test #10), then a solve of the new instance
+	status = hgs_set_instance(solver, n, x, y, NULL, s, d, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Solution *sol12h = hgs_reoptimize(solver, n, x10, y10, NULL, s10, d10, v_cap, 100000000, isRoundingInteger, 0, 2, sol, removed10, 1);
+	print_solution(sol12h);
+	int visits12h[10] = {0};
+	for (int i = 0; i < sol12h->n_routes; i++)
+		for (int j = 0; j < sol12h->routes[i].length; j++)
+			visits12h[sol12h->routes[i].path[j]]++;
+	for (int i = 1; i < n; i++)
+		assert(visits12h[i] == 1);
+	assert(sol12h->cost == 29);
+	struct Solution *sol12i = hgs_solve(solver);
+	assert(sol12i->cost == 29);
+	int removed12[] = {10};
+	struct Solution *sol12iInvalid = hgs_reoptimize(solver, n, x10, y10, NULL, s10, d10, v_cap, 100000000, isRoundingInteger, 0, 2, sol12i, removed12, 1);
+	assert(sol12iInvalid == NULL);
+	assert(hgs_last_error() == HGS_ERROR_INVALID_INPUT);
+
+	// Invalid instance: the handle remains usable afterwards
+	status = hgs_set_instance(solver, n, x, y, NULL, s, d, v_cap, 100000000, isRoundingInteger, 0, 1);
+	assert(status == -1);
+	struct Solution *sol12g = hgs_solve(solver);
+	assert(sol12g == NULL);
+	hgs_destroy(solver);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #13 (solver handle with a shared population) -----\n");
+
+	ap.nbThreads = 2;
+	ap.parallelScheme = 1;
+	solver = hgs_create(&ap, verbose);
+	status = hgs_set_instance(solver, n, x, y, NULL, s, d, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Solution *sol13a = hgs_solve(solver);
+	struct Solution *sol13b = hgs_solve(solver);
+	print_solution(sol13b);
+	assert(sol13a->cost == 29);
+	assert(sol13b->cost == 29);
+	hgs_destroy(solver);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #14 (borrowed distance matrix with a stride, and flat solution buffer) -----\n");
+
+	// The 10 x 10 matrix is stored in the first columns of a 10 x 12 buffer
+	double wide_mtx[10][12];
+	for (int i = 0; i < n; i++)
+		for (int j = 0; j < 12; j++)
+			wide_mtx[i][j] = (j < n) ? dist_mtx[i][j] : -1.;
+	ap = default_algorithm_parameters();
+	ap.timeLimit = 1.73; // seconds
+	ap.nbIter = 10000; // iterations
+	solver = hgs_create(&ap, verbose);
+	status = hgs_set_instance_view(solver, n, NULL, NULL, (double*)wide_mtx, 12, s, d, v_cap, 100000000, 0, 2);
+	assert(status == 0);
+	struct Solution *sol14a = hgs_solve(solver);
+	print_solution(sol14a);
+	assert(round(sol14a->cost) == round(sol2->cost));
+	int nbNodes14 = 0;
+	for (int r = 0; r < sol14a->n_routes; r++)
+	{
+		assert(sol14a->routes[r].path == sol14a->nodes + sol14a->route_offsets[r]);
+		assert(sol14a->route_offsets[r + 1] - sol14a->route_offsets[r] == sol14a->routes[r].length);
+		nbNodes14 += sol14a->routes[r].length;
+	}
+	assert(nbNodes14 == n - 1);
+
+	// The arc cost update works on a copy of the borrowed matrix
+	struct Solution *sol14b = hgs_update_arc_costs(solver, sol14a, arcFrom11, arcTo11, arcCost11, 1);
+	assert(sol14b->cost < sol2->cost + 10);
+	assert(wide_mtx[arcFrom11[0]][arcTo11[0]] == dist_mtx[arcFrom11[0]][arcTo11[0]]);
+	hgs_destroy(solver);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	printf("-------- test.c #15 (asynchronous solve stopped early, then cancelled) -----\n");
+
+	// With a time limit of 60 seconds, the search only ends early if the stop request is handled
+	ap = default_algorithm_parameters();
+	ap.timeLimit = 60; // seconds
+	solver = hgs_create(&ap, verbose);
+	status = hgs_set_instance(solver, n, x, y, NULL, s, d, v_cap, 100000000, isRoundingInteger, 0, 2);
+	assert(status == 0);
+	struct Progress progress15 = { 0, 1.e30 };
+	struct HGSJob *job = hgs_solve_async(solver, record_progress, &progress15);
+	assert(job != NULL);
+	while (hgs_job_best_cost(job) > 29.5) {}
+	hgs_job_stop(job);
+	struct Solution *sol15a = hgs_job_wait(job);
+	print_solution(sol15a);
+	assert(sol15a->cost == 29);
+	assert(sol15a->time < 30);
+	assert(progress15.nbCalls >= 1);
+	assert(progress15.lastCost == sol15a->cost);
+	delete_solution(sol15a);
+
+	job = hgs_solve_async(solver, NULL, NULL);
+	assert(job != NULL);
+	hgs_job_cancel(job);
+	struct Solution *sol15b = hgs_job_wait(job);
+	assert(sol15b == NULL);
+	hgs_destroy(solver);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 	delete_solution(sol);
 	delete_solution(sol2);
 	delete_solution(sol3);
@@ -199,6 +457,23 @@ int main()
 	delete_solution(sol5);
 	delete_solution(sol6);
 	delete_solution(sol7);
+	delete_solution(sol8);
+	delete_solution(sol9);
+	delete_solution(sol10);
+	delete_solution(sol11);
+	delete_solution(sol12a);
+	delete_solution(sol12b);
+	delete_solution(sol12c);
+	delete_solution(sol12d);
+	delete_solution(sol12e);
+	delete_solution(sol12e2);
+	delete_solution(sol12f);
+	delete_solution(sol12h);
+	delete_solution(sol12i);
+	delete_solution(sol13a);
+	delete_solution(sol13b);
+	delete_solution(sol14a);
+	delete_solution(sol14b);
 
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+// Stress test of the concurrent solves of the C interface: hundreds of short solves of the bundled instances run at the same time, from several caller threads and on the shared thread pool
+// Each solve is first run alone to get its reference cost: the concurrent solves should return exactly the same solutions (no hidden state is shared between the solves), and these solutions should be valid
+#include "C_Interface.h"
+#include "InstanceCVRPLIB.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cmath>
+#include <climits>
+
+struct TestInstance
+{
+	std::string name;				// Name of the instance file
+	bool isRoundingInteger;			// Rounding convention of the instance
+	InstanceCVRPLIB * data;			// Data of the instance
+};
+
+struct TestSolve
+{
+	int instance;					// Index of the instance
+	AlgorithmParameters ap;			// Parameters of the solve
+	double referenceCost;			// Cost of the solution when solved alone
+};
+
+static std::vector <TestInstance> instances;
+static std::vector <TestSolve> solves;
+static std::atomic <int> nbErrors(0);
+
+static void report_error(const std::string & message)
+{
+	static std::mutex outputMutex;
+	std::lock_guard <std::mutex> lock(outputMutex);
+	std::cout << "ERROR | " << message << std::endl;
+	nbErrors++;
+}
+
+// Creates a solver handle for a solve, with the instance loaded
+static HGSSolver * create_solver(const TestSolve & solve)
+{
+	InstanceCVRPLIB & cvrp = *instances[solve.instance].data;
+	int n = cvrp.nbClients + 1;
+	HGSSolver * solver = hgs_create(&solve.ap, 0);
+	if (solver == nullptr) { report_error(std::string("hgs_create failed: ") + hgs_last_error_message()); return nullptr; }
+	int status = hgs_set_instance(solver, n, cvrp.x_coords.data(), cvrp.y_coords.data(), nullptr, cvrp.service_time.data(), cvrp.demands.data(),
+		cvrp.vehicleCapacity, cvrp.durationLimit, instances[solve.instance].isRoundingInteger, cvrp.isDurationConstraint, INT_MAX);
+	if (status != HGS_OK) { report_error(std::string("hgs_set_instance failed: ") + hgs_last_error_message()); hgs_destroy(solver); return nullptr; }
+	return solver;
+}
+
+// Checks that a solution visits each client once, and that its cost matches its routes. Returns its cost (-1 if invalid)
+static double check_solution(const TestSolve & solve, const Solution * sol)
+{
+	if (sol == nullptr) { report_error("No solution returned"); return -1.; }
+	InstanceCVRPLIB & cvrp = *instances[solve.instance].data;
+	std::vector <int> nbVisits(cvrp.nbClients + 1, 0);
+	double cost = 0.;
+	for (int r = 0; r < sol->n_routes; r++)
+	{
+		double load = 0.;
+		double duration = 0.;
+		int previous = 0;
+		for (int k = 0; k < sol->routes[r].length; k++)
+		{
+			int client = sol->routes[r].path[k];
+			if (client < 1 || client > cvrp.nbClients) { report_error("Invalid client in a route"); return -1.; }
+			nbVisits[client]++;
+			load += cvrp.demands[client];
+			duration += cvrp.dist_mtx[previous][client] + cvrp.service_time[client];
+			cost += cvrp.dist_mtx[previous][client];
+			previous = client;
+		}
+		duration += cvrp.dist_mtx[previous][0];
+		cost += cvrp.dist_mtx[previous][0];
+		if (load > cvrp.vehicleCapacity + 1.e-5) { report_error("Capacity exceeded"); return -1.; }
+		if (cvrp.isDurationConstraint && duration > cvrp.durationLimit + 1.e-5) { report_error("Duration limit exceeded"); return -1.; }
+	}
+	for (int i = 1; i <= cvrp.nbClients; i++)
+		if (nbVisits[i] != 1) { report_error("A client is not visited exactly once"); return -1.; }
+	if (std::abs(cost - sol->cost) > 1.e-3) { report_error("The cost does not match the routes"); return -1.; }
+	return sol->cost;
+}
+
+static void check_cost(const TestSolve & solve, const Solution * sol, const std::string & mode)
+{
+	double cost = check_solution(solve, sol);
+	if (cost >= 0. && std::abs(cost - solve.referenceCost) > 1.e-6)
+		report_error(mode + ": cost " + std::to_string(cost) + " instead of " + std::to_string(solve.referenceCost) + " on " + instances[solve.instance].name + " with seed " + std::to_string(solve.ap.seed));
+}
+
+// Caller thread solving its share of the solves with its own handles
+static void run_caller_thread(int threadIndex, int nbThreads)
+{
+	for (int s = threadIndex; s < (int)solves.size(); s += nbThreads)
+	{
+		HGSSolver * solver = create_solver(solves[s]);
+		if (solver == nullptr) continue;
+		Solution * sol = hgs_solve(solver);
+		check_cost(solves[s], sol, "Concurrent solve");
+		if (sol != nullptr) delete_solution(sol);
+		hgs_destroy(solver);
+
+		// An invalid call only sets the error of this thread
+		if (s % 10 == threadIndex)
+		{
+			HGSSolver * invalid = hgs_create(&solves[s].ap, 0);
+			double demand = 0.;
+			if (hgs_set_instance(invalid, 1, &demand, &demand, nullptr, &demand, &demand, 10., 1.e30, 0, 0, INT_MAX) != HGS_ERROR_INVALID_INPUT
+				|| hgs_last_error() != HGS_ERROR_INVALID_INPUT || hgs_last_error_message()[0] == '\0')
+				report_error("An invalid instance is not reported");
+			hgs_destroy(invalid);
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2) { std::cout << "Usage: lib_test_concurrency instancesDirectory" << std::endl; return 1; }
+	try
+	{
+		instances = { { "X-n101-k25", true, nullptr }, { "CMT1", false, nullptr }, { "CMT6", false, nullptr } };
+		for (TestInstance & instance : instances)
+			instance.data = new InstanceCVRPLIB(std::string(argv[1]) + "/" + instance.name + ".vrp", instance.isRoundingInteger);
+	}
+	catch (const std::string & e) { std::cout << "EXCEPTION | " << e << std::endl; return 1; }
+
+	// Short solves with different seeds, some of them with two deterministic islands
+	for (int seed = 1; seed <= 40; seed++)
+	{
+		for (int i = 0; i < (int)instances.size(); i++)
+		{
+			TestSolve solve;
+			solve.instance = i;
+			solve.ap = default_algorithm_parameters();
+			solve.ap.mu = 10;
+			solve.ap.lambda = 10;
+			solve.ap.nbIter = 50;
+			solve.ap.nbIterTraces = INT_MAX;
+			solve.ap.seed = seed;
+			if (seed % 8 == 0)
+			{
+				solve.ap.nbThreads = 2;
+				solve.ap.deterministic = 1;
+			}
+			solve.referenceCost = -1.;
+			solves.push_back(solve);
+		}
+	}
+
+	// Reference costs, solved one at a time
+	for (TestSolve & solve : solves)
+	{
+		HGSSolver * solver = create_solver(solve);
+		if (solver == nullptr) return 1;
+		Solution * sol = hgs_solve(solver);
+		solve.referenceCost = check_solution(solve, sol);
+		if (sol != nullptr) delete_solution(sol);
+		hgs_destroy(solver);
+	}
+	if (nbErrors > 0) return 1;
+
+	// All solves again at the same time: asynchronous solves on the shared pool, while caller threads solve the same configurations with their own handles
+	if (hgs_set_pool_size(3) != HGS_OK) { std::cout << "ERROR | The pool size cannot be set" << std::endl; return 1; }
+	std::vector <HGSSolver *> jobSolvers(solves.size(), nullptr);
+	std::vector <HGSJob *> jobs(solves.size(), nullptr);
+	for (int s = 0; s < (int)solves.size(); s++)
+	{
+		jobSolvers[s] = create_solver(solves[s]);
+		if (jobSolvers[s] == nullptr) continue;
+		jobs[s] = hgs_solve_async(jobSolvers[s], nullptr, nullptr);
+		if (jobs[s] == nullptr) report_error(std::string("hgs_solve_async failed: ") + hgs_last_error_message());
+	}
+	if (hgs_set_pool_size(2) != HGS_ERROR_INVALID_INPUT) report_error("The pool size is changed after the start of the pool");
+
+	// Some of the queued jobs are cancelled: they end without a solution and without an error
+	std::vector <bool> isCancelled(solves.size(), false);
+	for (int s = (int)solves.size() - 1; s >= 0; s -= 25)
+	{
+		isCancelled[s] = true;
+		if (jobs[s] != nullptr) hgs_job_cancel(jobs[s]);
+	}
+
+	const int nbCallerThreads = 4;
+	std::vector <std::thread> callerThreads;
+	for (int t = 0; t < nbCallerThreads; t++) callerThreads.emplace_back(run_caller_thread, t, nbCallerThreads);
+	for (std::thread & thread : callerThreads) thread.join();
+
+	int nbJobsSolved = 0;
+	for (int s = 0; s < (int)solves.size(); s++)
+	{
+		if (jobs[s] == nullptr) continue;
+		Solution * sol = hgs_job_wait(jobs[s]);
+		if (isCancelled[s])
+		{
+			// A cancelled job may have started before its cancellation, but its solution is discarded
+			if (sol != nullptr) report_error("A cancelled job returned a solution");
+		}
+		else
+		{
+			check_cost(solves[s], sol, "Asynchronous solve");
+			nbJobsSolved++;
+		}
+		if (sol != nullptr) delete_solution(sol);
+		hgs_destroy(jobSolvers[s]);
+	}
+
+	std::cout << "SOLVES: " << solves.size() << " ALONE, " << solves.size() << " FROM " << nbCallerThreads << " CALLER THREADS, " << nbJobsSolved << " ASYNCHRONOUS" << std::endl;
+	std::cout << "ERRORS: " << nbErrors << std::endl;
+	for (TestInstance & instance : instances) delete instance.data;
+	return (nbErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+# Checks the Python extension module: solves from coordinates and from a borrowed distance matrix, errors, and parallel solves from Python threads with the GIL released
+import threading
+import time
+import numpy as np
+import hgscvrp
+
+x = np.array([1, 2, 3, 4, 5, 6, 7, 8, 9, 10], dtype=np.float64)
+y = np.array([5, 4, 3, 2, 1, 9, 8, 7, 6, 5], dtype=np.float64)
+demands = np.array([0, 2, 3, 1, 2, 3, 1, 2, 3, 1], dtype=np.float64)
+
+# Solve from the coordinates
+result = hgscvrp.solve(demands, 10, x=x, y=y, vehicles=2, params={"nbIter": 2000, "seed": 1})
+assert result["cost"] == 29
+assert sorted(np.concatenate(result["routes"]).tolist()) == list(range(1, 10))
+assert all(route.dtype == np.int32 for route in result["routes"])
+
+# Solve from a distance matrix, which is borrowed without a copy and never written
+distances = np.round(np.hypot(x[:, None] - x[None, :], y[:, None] - y[None, :]))
+before = distances.copy()
+solver = hgscvrp.Solver(params={"nbIter": 2000})
+result = solver.solve(demands, 10, distances=distances, vehicles=2)
+assert result["cost"] == 29
+assert np.array_equal(distances, before)
+
+# The rows of the matrix may be strided (view of a larger matrix)
+padded = np.zeros((10, 12))
+padded[:, :10] = distances
+result = solver.solve(demands, 10, distances=padded[:, :10], vehicles=2)
+assert result["cost"] == 29
+
+# Errors of the library become Python exceptions
+for call in (lambda: hgscvrp.solve(demands, 10), lambda: hgscvrp.solve(demands[:1], 10, x=x[:1], y=y[:1]), lambda: hgscvrp.Solver(params={"unknown": 1})):
+    try:
+        call()
+        assert False, "An exception was expected"
+    except ValueError:
+        pass
+
+# Solves from several Python threads: the GIL is released during the solves, so the main thread keeps running
+results = [None] * 4
+def run(index):
+    results[index] = hgscvrp.solve(demands, 10, x=x, y=y, vehicles=2, params={"nbIter": 100000, "timeLimit": 0.5, "seed": index})
+threads = [threading.Thread(target=run, args=(index,)) for index in range(4)]
+start = time.time()
+for thread in threads:
+    thread.start()
+nbLoops = 0
+while any(thread.is_alive() for thread in threads):
+    nbLoops += 1
+    time.sleep(0.001)
+for thread in threads:
+    thread.join()
+assert all(result["cost"] == 29 for result in results)
+assert nbLoops > 10, "The main thread was blocked during the solves"
+print("OK, %d loops of the main thread during %.2f s of parallel solves" % (nbLoops, time.time() - start))
@@ -0,0 +1,47 @@
+# delete artifacts from previous runs, if any
+file(REMOVE batch_results.csv)
+
+# manifest of the instances, with a comment, an empty line, paths relative to the manifest and a BKS value
+file(WRITE batch_manifest.txt "# instances of the batch test\n../Instances/CVRP/CMT1.vrp\n\n../Instances/CVRP/X-n101-k25.vrp 27591\n")
+
+# solve each instance with two seeds, on two workers
+execute_process(
+        COMMAND ./hgs_batch batch_manifest.txt batch_results.csv -seed 3 -seeds 2 -it 3000 -workers 2
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+)
+message(${output})
+if(NOT ${result} EQUAL 0)
+    message(SEND_ERROR "Test error for the batch mode. The executable ended with ${result}")
+endif()
+
+# one row per run, the largest instance first, with the same costs as the executable
+file(STRINGS batch_results.csv rows)
+list(LENGTH rows nb_rows)
+if(NOT ${nb_rows} EQUAL 5)
+    message(SEND_ERROR "Test error for the batch mode. ${nb_rows} rows instead of 5")
+endif()
+list(GET rows 1 first_run)
+if(NOT "${first_run}" MATCHES "^X-n101-k25,100,")
+    message(SEND_ERROR "Test error for the batch mode. The first run is not the largest instance: ${first_run}")
+endif()
+foreach(expected
+        "instance,nbClients,seed,cost,nbRoutes,time,timeBest,nbIterations,nbLocalSearches,bks,gap,timeTo2%,timeTo1%,timeTo0.5%,timeTo0.1%"
+        "X-n101-k25,100,3,27591,"
+        "X-n101-k25,100,4,27591,"
+        "CMT1,50,3,521,"
+        "CMT1,50,4,521,")
+    string(FIND "${rows}" "${expected}" position)
+    if(${position} EQUAL -1)
+        message(SEND_ERROR "Test error for the batch mode. Missing row: ${expected}")
+    endif()
+endforeach()
+
+# the gap and the times to target are given for the instance with a BKS only
+if(NOT "${first_run}" MATCHES ",27591,0,[-+.e0-9]+,[-+.e0-9]+,[-+.e0-9]+,[-+.e0-9]+$")
+    message(SEND_ERROR "Test error for the batch mode. Missing gap or times to target: ${first_run}")
+endif()
+list(GET rows 4 last_run)
+if(NOT "${last_run}" MATCHES ",,,,,,$")
+    message(SEND_ERROR "Test error for the batch mode. Gap given without BKS: ${last_run}")
+endif()
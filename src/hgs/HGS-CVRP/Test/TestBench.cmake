@@ -0,0 +1,55 @@
+# delete artifacts from previous runs, if any
+file(REMOVE bench.json bench_compared.json bench_faster.json)
+
+# manifest of the instances, with their BKS values and rounding conventions
+file(WRITE bench_manifest.txt "../Instances/CVRP/CMT1.vrp 524.61 0\n../Instances/CVRP/X-n101-k25.vrp 27591 1\n")
+
+# benchmark, with two seeds per instance
+execute_process(
+        COMMAND ./hgs_bench bench_manifest.txt bench.json -it 500 -seeds 2 -log 0
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+)
+message(${output})
+if(NOT ${result} EQUAL 0)
+    message(SEND_ERROR "Test error for the benchmark. The executable ended with ${result}")
+endif()
+file(READ bench.json summary)
+foreach(expected
+        "\"overall\":{\"instance\":\"overall\",\"nbRuns\":4,\"nbSolved\":4,"
+        "{\"instance\":\"CMT1\",\"nbRuns\":2,"
+        "{\"instance\":\"X-n101-k25\",\"nbRuns\":2,"
+        "\"iterationsPerSecond\":"
+        "\"localSearchesPerSecond\":"
+        "\"timeToTarget\":{\"2\":["
+        "\"bks\":524.61,")
+    string(FIND "${summary}" "${expected}" position)
+    if(${position} EQUAL -1)
+        message(SEND_ERROR "Test error for the benchmark. Missing in the summary: ${expected}")
+    endif()
+endforeach()
+
+# comparison with itself as baseline: no regression
+execute_process(
+        COMMAND ./hgs_bench bench_manifest.txt bench_compared.json -it 500 -seeds 2 -log 0 -baseline bench.json -tolerance 50
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+)
+message(${output})
+if(NOT ${result} EQUAL 0)
+    message(SEND_ERROR "Test error for the benchmark. A regression was detected against the same code")
+endif()
+
+# comparison with a much faster baseline: regression
+string(REGEX REPLACE "\"iterationsPerSecond\":[-+.e0-9]+" "\"iterationsPerSecond\":1e12" faster "${summary}")
+file(WRITE bench_faster.json "${faster}")
+execute_process(
+        COMMAND ./hgs_bench bench_manifest.txt bench_compared.json -it 500 -log 0 -baseline bench_faster.json
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+)
+message(${output})
+string(FIND "${output}" "THROUGHPUT REGRESSION" position)
+if(${result} EQUAL 0 OR ${position} EQUAL -1)
+    message(SEND_ERROR "Test error for the benchmark. The regression against a faster baseline was not detected")
+endif()
@@ -0,0 +1,26 @@
+# solve the requests of a NDJSON file with the daemon mode, reading the standard input
+execute_process(
+        COMMAND ./hgs -daemon stdin -workers 2 -seed 1
+        INPUT_FILE ${REQUESTS}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+)
+message(${output})
+if(NOT ${result} EQUAL 0)
+    message(SEND_ERROR "Test error for the daemon mode. The daemon ended with ${result}")
+endif()
+
+# each request must be answered, the valid ones with the optimal solution
+foreach(expected
+        "{\"id\":\"coordinates\",\"event\":\"progress\""
+        "{\"id\":\"coordinates\",\"event\":\"solution\",\"cost\":29,"
+        "{\"id\":\"matrix\",\"event\":\"solution\",\"cost\":29,"
+        "{\"id\":\"reused\",\"event\":\"solution\",\"cost\":29,"
+        "{\"id\":\"invalid\",\"event\":\"error\",\"code\":\"invalid_input\""
+        "{\"id\":\"unknown\",\"event\":\"error\",\"code\":\"invalid_input\""
+        "{\"id\":null,\"event\":\"error\",\"code\":\"invalid_input\"")
+    string(FIND "${output}" "${expected}" position)
+    if(${position} EQUAL -1)
+        message(SEND_ERROR "Test error for the daemon mode. Missing response: ${expected}")
+    endif()
+endforeach()
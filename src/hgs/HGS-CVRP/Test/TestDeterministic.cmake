@@ -0,0 +1,45 @@
+
+# delete artifacts from previous runs, if any
+file(REMOVE mySolution1.sol mySolution2.sol)
+
+# additional arguments of the executable (given as a single space-separated string)
+separate_arguments(ARGS)
+
+# solve the given instance twice in the deterministic mode
+# (with MAX_GAP, the first run is logged to check that the search stopped early on the gap to the lower bound)
+foreach(run 1 2)
+    set(log 0)
+    if(DEFINED MAX_GAP AND run EQUAL 1)
+        set(log 1)
+    endif()
+    execute_process(
+            COMMAND ./hgs ../Instances/CVRP/${INSTANCE}.vrp mySolution${run}.sol -seed 1 -log ${log} -deterministic 1 ${ARGS}
+            RESULTS_VARIABLE result
+            OUTPUT_VARIABLE output${run}
+    )
+    message(${result})
+endforeach()
+
+# the two solution files must be identical
+execute_process(
+        COMMAND ${CMAKE_COMMAND} -E compare_files mySolution1.sol mySolution2.sol
+        RESULT_VARIABLE different
+)
+if(NOT ${different} EQUAL 0)
+    message(SEND_ERROR "Test error for ${INSTANCE}. The deterministic runs gave different solutions")
+endif()
+
+# the gap of the best solution must be within MAX_GAP percent, reached in less than MAX_ITERATIONS iterations
+if(DEFINED MAX_GAP)
+    string(REGEX MATCH "GAP OF THE BEST SOLUTION: ([0-9.]+)%" match "${output1}")
+    set(gap ${CMAKE_MATCH_1})
+    string(REGEX MATCH "GENETIC ALGORITHM FINISHED AFTER ([0-9]+) ITERATIONS" match "${output1}")
+    set(iterations ${CMAKE_MATCH_1})
+    if("${gap}" STREQUAL "" OR "${iterations}" STREQUAL "")
+        message(SEND_ERROR "Test error for ${INSTANCE}. The gap or the number of iterations was not reported")
+    elseif(${gap} GREATER ${MAX_GAP} OR NOT ${iterations} LESS ${MAX_ITERATIONS})
+        message(SEND_ERROR "Test error for ${INSTANCE}. The search did not stop on the gap (gap ${gap}%, ${iterations} iterations)")
+    else()
+        message("Gap of the best solution: ${gap}% after ${iterations} iterations")
+    endif()
+endif()
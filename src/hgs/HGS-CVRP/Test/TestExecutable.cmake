@@ -3,9 +3,12 @@
 file(REMOVE mySolution.sol)
 file(REMOVE mySolution.sol.PG.csv)
 
+# additional arguments of the executable, if any (given as a single space-separated string)
+separate_arguments(ARGS)
+
 # solve the given instance
 execute_process(
-        COMMAND ./hgs ../Instances/CVRP/${INSTANCE}.vrp mySolution.sol -seed 1 -round ${ROUND}
+        COMMAND ./hgs ../Instances/CVRP/${INSTANCE}.vrp mySolution.sol -seed 1 -round ${ROUND} ${ARGS}
         RESULTS_VARIABLE result
 )
 message(${result})
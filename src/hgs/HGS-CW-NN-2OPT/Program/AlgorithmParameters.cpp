@@ -25,6 +25,7 @@ struct AlgorithmParameters default_algorithm_parameters() {
     ap.nbIterTraces = 500;        // Sin cambios
     ap.timeLimit = 120;           // Sin cambios
     ap.useSwapStar = 1;           // Sin cambios
+    ap.timeLimitPolishing = 5;
 
 
 	return ap;
@@ -47,5 +48,6 @@ void print_algorithm_parameters(const AlgorithmParameters & ap)
 	std::cout << "---- nbIterTraces            is set to " << ap.nbIterTraces << std::endl;
 	std::cout << "---- timeLimit               is set to " << ap.timeLimit << std::endl;
 	std::cout << "---- useSwapStar             is set to " << ap.useSwapStar << std::endl;
+	std::cout << "---- timeLimitPolishing      is set to " << ap.timeLimitPolishing << std::endl;
 	std::cout << "==================================================" << std::endl;
 }
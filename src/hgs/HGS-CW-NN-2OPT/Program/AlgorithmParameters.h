@@ -22,8 +22,9 @@ struct AlgorithmParameters {
 	int seed;				// Random seed. Default value: 0
 	int nbIter;				// Nb iterations without improvement until termination (or restart if a time limit is specified). Default value: 20,000 iterations
 	int nbIterTraces;       // Number of iterations between traces display during HGS execution
-	double timeLimit;		// CPU time limit until termination in seconds. Default value: 0 (i.e., inactive)
+	double timeLimit;		// Time limit until termination in seconds (wall-clock time). Default value: 0 (i.e., inactive)
 	int useSwapStar;		// Use SWAP* local search or not. Default value: 1. Only available when coordinates are provided.
+	double timeLimitPolishing;	// Time budget in seconds of the polishing of the best solution, reserved at the end of the time limit. Default value: 5
 };
 
 #ifdef __cplusplus
@@ -11,7 +11,7 @@ Solution *prepare_solution(Population &population, Params &params)
 {
 	// Preparing the best solution
 	Solution *sol = new Solution;
-	sol->time = (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC;
+	sol->time = params.deadline.getElapsedTime();
 
 	if (population.getBestFound() != nullptr) {
 		// Best individual
@@ -0,0 +1,49 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <chrono>
+#include <algorithm>
+
+// Time budgets of the algorithm, measured in wall-clock time with a monotonic clock
+// Unlike clock(), which measures the CPU time of the process (summed over all threads), this time does not run faster when several threads are used and includes I/O waits
+// The overall budget is split into two phases: the genetic algorithm (population constructions included), then the polishing of the best solution, whose budget is reserved at the end
+class Deadline
+{
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	Clock::time_point startTime;			// Start time of the optimization
+	Clock::time_point endTime;				// End of the overall time budget (if isLimited)
+	Clock::time_point phaseEndTime;			// End of the time budget of the current phase (if isLimited)
+	double polishingTimeLimit;				// Time budget of the polishing phase in seconds
+	bool isLimited;							// Tells if the overall time budget is limited
+
+	// Elapsed wall-clock time since the start, in seconds
+	double getElapsedTime() const { return std::chrono::duration<double>(Clock::now() - startTime).count(); }
+
+	// Tells if the overall time budget is exhausted
+	bool isOver() const { return isLimited && Clock::now() >= endTime; }
+
+	// Tells if the time budget of the current phase is exhausted
+	bool isPhaseOver() const { return isLimited && Clock::now() >= phaseEndTime; }
+
+	// Starts the polishing phase, which ends after polishingTimeLimit seconds or at the end of the overall budget
+	void startPolishing()
+	{
+		phaseEndTime = std::min<Clock::time_point>(endTime, Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(polishingTimeLimit)));
+	}
+
+	// Starts the clock and the genetic algorithm phase, with the given time budgets in seconds (timeLimit = 0 if not limited)
+	// The genetic algorithm ends polishingTimeLimit seconds before the end of the overall budget
+	void start(double timeLimit, double polishingTimeLimit)
+	{
+		startTime = Clock::now();
+		isLimited = (timeLimit > 0);
+		this->polishingTimeLimit = polishingTimeLimit;
+		endTime = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeLimit));
+		phaseEndTime = std::max<Clock::time_point>(startTime, endTime - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(polishingTimeLimit)));
+	}
+};
+
+#endif
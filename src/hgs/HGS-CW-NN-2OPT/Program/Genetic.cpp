@@ -9,7 +9,7 @@ void Genetic::run()
     int nbIter;
     int nbIterNonProd = 1;
     if (params.verbose) std::cout << "----- STARTING GENETIC ALGORITHM" << std::endl;
-    for (nbIter = 0; (params.ap.timeLimit == 0 || (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC < params.ap.timeLimit) && nbIter <= params.ap.nbIter; nbIter++)
+    for (nbIter = 0; !params.deadline.isPhaseOver() && nbIter <= params.ap.nbIter; nbIter++)
     {
         /* SELECTION AND CROSSOVER */
         crossoverOX(offspring, population.getBinaryTournament(), population.getBinaryTournament());
@@ -31,23 +31,24 @@ void Genetic::run()
         if (nbIter % params.ap.nbIterPenaltyManagement == 0) population.managePenalties();
         if (nbIter % params.ap.nbIterTraces == 0) population.printState(nbIter, nbIterNonProd);
 
-        /* RESTART MECHANISM */
-        if (nbIterNonProd >= maxIterNonProd && (params.ap.timeLimit == 0 || (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC < params.ap.timeLimit - 5))
+        /* RESTART MECHANISM (NOT TRIGGERED IF THE BUDGET OF THE GENETIC ALGORITHM HAS BEEN EXHAUSTED DURING THIS ITERATION) */
+        if (nbIterNonProd >= maxIterNonProd && !params.deadline.isPhaseOver())
         {
             if (params.verbose) std::cout << "----- TRIGGERING POPULATION RESTART AFTER " << nbIterNonProd << " ITERATIONS WITHOUT IMPROVEMENT" << std::endl;
             population.restart();
             nbIterNonProd = 1;
         }
     }
-    if (params.verbose) std::cout << "----- GENETIC ALGORITHM FINISHED AFTER " << nbIter << " ITERATIONS. TIME SPENT: " << (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC << std::endl;
+    if (params.verbose) std::cout << "----- GENETIC ALGORITHM FINISHED AFTER " << nbIter << " ITERATIONS. TIME SPENT: " << params.deadline.getElapsedTime() << std::endl;
 
-    /* POLISHING PHASE */
+    /* POLISHING PHASE, WITHIN ITS OWN TIME BUDGET (THE LOCAL SEARCH STOPS AT THE END OF THIS BUDGET) */
     if (params.verbose) std::cout << "----- POLISHING BEST SOLUTION" << std::endl;
+    params.deadline.startPolishing();
     const Individual* best = population.getBestFound();
     if (best != nullptr)
     {
         Individual polished(*best);
-        if (params.ap.timeLimit == 0 || (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC < params.ap.timeLimit - 5)
+        if (!params.deadline.isPhaseOver())
         {
             localSearch.run(polished, params.penaltyCapacity * 100., params.penaltyDuration * 100.);
             population.addIndividual(polished, true);
@@ -1,127 +1,130 @@
 #include "InitialSeeds.h"
-     #include <vector>
-     #include <algorithm>
-     #include <cmath>
+#include <queue>
 
-     Individual ClarkeWrightSeed(Params &params) {
-         Individual ind(params);
-         // Implementación simplificada de Clarke-Wright
-         std::vector<std::vector<int>> routes;
-         std::vector<bool> visited(params.nbClients + 1, false);
-         visited[0] = true;
+// Union-find with path halving, used to identify the route of each client during the savings merges
+static int findRoute(std::vector <int> & parent, int i)
+{
+	while (parent[i] != i)
+	{
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
 
-         // Calcular ahorros
-         struct Saving {
-             int i, j;
-             double saving;
-         };
-         std::vector<Saving> savings;
-         for (int i = 1; i <= params.nbClients; ++i) {
-             for (int j = i + 1; j <= params.nbClients; ++j) {
-                 double dist_i0 = sqrt(pow(params.instance.x_coords[i] - params.instance.x_coords[0], 2) +
-                                       pow(params.instance.y_coords[i] - params.instance.y_coords[0], 2));
-                 double dist_j0 = sqrt(pow(params.instance.x_coords[j] - params.instance.x_coords[0], 2) +
-                                       pow(params.instance.y_coords[j] - params.instance.y_coords[0], 2));
-                 double dist_ij = sqrt(pow(params.instance.x_coords[i] - params.instance.x_coords[j], 2) +
-                                       pow(params.instance.y_coords[i] - params.instance.y_coords[j], 2));
-                 savings.push_back({i, j, dist_i0 + dist_j0 - dist_ij});
-             }
-         }
-         std::sort(savings.begin(), savings.end(), [](const Saving &a, const Saving &b) {
-             return a.saving > b.saving;
-         });
+Individual ClarkeWrightSeed(Params & params)
+{
+	Individual indiv(params);
+	int n = params.nbClients;
 
-         // Construir rutas
-         for (const auto &s : savings) {
-             if (!visited[s.i] && !visited[s.j]) {
-                 routes.push_back({0, s.i, s.j, 0});
-                 visited[s.i] = visited[s.j] = true;
-             } else if (!visited[s.i] || !visited[s.j]) {
-                 for (auto &route : routes) {
-                     if (route.size() - 2 < 12) { // Respetar capacidad
-                         if (!visited[s.i]) {
-                             route.insert(route.end() - 1, s.i);
-                             visited[s.i] = true;
-                         } else if (!visited[s.j]) {
-                             route.insert(route.end() - 1, s.j);
-                             visited[s.j] = true;
-                         }
-                     }
-                 }
-             }
-         }
+	// Initially, each client is served by its own route. Routes are stored as linked lists (next), and identified by their union-find representative
+	std::vector <int> parent(n + 1);
+	std::vector <int> next(n + 1, 0);
+	std::vector <int> head(n + 1);
+	std::vector <int> tail(n + 1);
+	std::vector <double> load(n + 1);
+	std::vector <double> duration(n + 1);
+	for (int i = 1; i <= n; i++)
+	{
+		parent[i] = i;
+		head[i] = i;
+		tail[i] = i;
+		load[i] = params.cli[i].demand;
+		duration[i] = params.timeCost[0][i] + params.cli[i].serviceDuration + params.timeCost[i][0];
+	}
 
-         // Añadir clientes no visitados
-         for (int i = 1; i <= params.nbClients; ++i) {
-             if (!visited[i]) {
-                 for (auto &route : routes) {
-                     if (route.size() - 2 < 12) {
-                         route.insert(route.end() - 1, i);
-                         visited[i] = true;
-                         break;
-                     }
-                 }
-             }
-         }
+	// Positive savings of the arcs towards the correlated vertices
+	std::priority_queue < std::pair < double, std::pair <int, int> > > savings;
+	for (int i = 1; i <= n; i++)
+	{
+		for (int j : params.correlatedVertices[i])
+		{
+			double saving = params.timeCost[i][0] + params.timeCost[0][j] - params.timeCost[i][j];
+			if (saving > MY_EPSILON) savings.push({ saving, { i, j } });
+		}
+	}
 
-         // Convertir a chromT
-         int pos = 0;
-         for (const auto &route : routes) {
-             for (size_t i = 1; i < route.size() - 1; ++i) {
-                 ind.chromT[pos++] = route[i];
-             }
-         }
-         ind.eval.nbRoutes = routes.size();
-         return ind;
-     }
+	// Merging the routes by decreasing savings: the route ending with i is followed by the route starting with j
+	while (!savings.empty())
+	{
+		double saving = savings.top().first;
+		int i = savings.top().second.first;
+		int j = savings.top().second.second;
+		savings.pop();
+		int routeI = findRoute(parent, i);
+		int routeJ = findRoute(parent, j);
+		if (routeI == routeJ || tail[routeI] != i || head[routeJ] != j) continue;
+		if (load[routeI] + load[routeJ] > params.vehicleCapacity + MY_EPSILON) continue;
+		if (params.isDurationConstraint && duration[routeI] + duration[routeJ] - saving > params.durationLimit + MY_EPSILON) continue;
 
-     Individual NearestNeighborSeed(Params &params) {
-         Individual ind(params);
-         std::vector<bool> visited(params.nbClients + 1, false);
-         visited[0] = true;
-         std::vector<std::vector<int>> routes(20, {0}); // 20 vehículos
-         int routeIdx = 0;
+		next[i] = j;
+		parent[routeJ] = routeI;
+		tail[routeI] = tail[routeJ];
+		load[routeI] += load[routeJ];
+		duration[routeI] += duration[routeJ] - saving;
+	}
 
-         for (int i = 0; i < params.nbClients; ++i) {
-             int current = routes[routeIdx].back();
-             double minDist = 1e30;
-             int next = -1;
-             for (int j = 1; j <= params.nbClients; ++j) {
-                 if (!visited[j]) {
-                     double dist = sqrt(pow(params.instance.x_coords[current] - params.instance.x_coords[j], 2) +
-                                        pow(params.instance.y_coords[current] - params.instance.y_coords[j], 2));
-                     if (dist < minDist) {
-                         minDist = dist;
-                         next = j;
-                     }
-                 }
-             }
-             if (next == -1 || routes[routeIdx].size() - 1 >= 12) {
-                 routes[routeIdx].push_back(0);
-                 routeIdx = (routeIdx + 1) % 20;
-                 if (next == -1) break;
-             }
-             routes[routeIdx].push_back(next);
-             visited[next] = true;
-         }
+	// Concatenating the routes in the giant tour. If there are more routes than vehicles, Split merges some of them
+	int position = 0;
+	for (int i = 1; i <= n; i++)
+		if (findRoute(parent, i) == i)
+			for (int client = head[i]; client != 0; client = next[client])
+				indiv.chromT[position++] = client;
+	return indiv;
+}
 
-         // Convertir a chromT
-         int pos = 0;
-         for (const auto &route : routes) {
-             for (size_t i = 1; i < route.size() - 1; ++i) {
-                 ind.chromT[pos++] = route[i];
-             }
-         }
-         ind.eval.nbRoutes = 20;
-         return ind;
-     }
+Individual NearestNeighborSeed(Params & params)
+{
+	Individual indiv(params);
+	int n = params.nbClients;
 
-     Individual RandomKeySeed(Params &params) {
-         Individual ind(params);
-         std::vector<int> clients(params.nbClients);
-         for (int i = 0; i < params.nbClients; ++i) clients[i] = i + 1;
-         std::shuffle(clients.begin(), clients.end(), params.ran);
-         for (int i = 0; i < params.nbClients; ++i) ind.chromT[i] = clients[i];
-         ind.eval.nbRoutes = 20;
-         return ind;
-     }
+	// Clients by increasing distance from the depot, to start the new routes
+	std::vector <int> clientsByDepotDistance(n);
+	for (int i = 0; i < n; i++) clientsByDepotDistance[i] = i + 1;
+	std::sort(clientsByDepotDistance.begin(), clientsByDepotDistance.end(), [&params](int i, int j) { return params.timeCost[0][i] < params.timeCost[0][j]; });
+
+	std::vector <bool> isVisited(n + 1, false);
+	int nextStart = 0;
+	int current = 0;
+	double load = 0.;
+	double duration = 0.;
+	for (int position = 0; position < n; position++)
+	{
+		// Closest unvisited correlated vertex which fits in the current route
+		int bestClient = -1;
+		double bestDistance = 1.e30;
+		if (current != 0)
+		{
+			for (int j : params.correlatedVertices[current])
+			{
+				if (isVisited[j] || params.timeCost[current][j] >= bestDistance) continue;
+				if (load + params.cli[j].demand > params.vehicleCapacity + MY_EPSILON) continue;
+				if (params.isDurationConstraint && duration + params.timeCost[current][j] + params.cli[j].serviceDuration + params.timeCost[j][0] > params.durationLimit + MY_EPSILON) continue;
+				bestClient = j;
+				bestDistance = params.timeCost[current][j];
+			}
+		}
+
+		// Otherwise, starting a new route with the unvisited client closest to the depot
+		if (bestClient == -1)
+		{
+			while (isVisited[clientsByDepotDistance[nextStart]]) nextStart++;
+			bestClient = clientsByDepotDistance[nextStart];
+			current = 0;
+			load = 0.;
+			duration = 0.;
+		}
+
+		load += params.cli[bestClient].demand;
+		duration += params.timeCost[current][bestClient] + params.cli[bestClient].serviceDuration;
+		isVisited[bestClient] = true;
+		indiv.chromT[position] = bestClient;
+		current = bestClient;
+	}
+	return indiv;
+}
+
+Individual RandomKeySeed(Params & params)
+{
+	return Individual(params);
+}
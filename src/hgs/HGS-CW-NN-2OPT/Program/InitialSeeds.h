@@ -1,11 +1,21 @@
 #ifndef INITIAL_SEEDS_H
-     #define INITIAL_SEEDS_H
+#define INITIAL_SEEDS_H
 
-     #include "Individual.h"
-     #include "Params.h"
+#include "Individual.h"
 
-     Individual ClarkeWrightSeed(Params &params);
-     Individual NearestNeighborSeed(Params &params);
-     Individual RandomKeySeed(Params &params);
+// Constructive heuristics used to seed the initial population
+// They only build a giant tour (chromT, routes concatenated in their visit order), which is then segmented into routes by the Split algorithm
+// Both heuristics are restricted to the correlated vertices of each client, such that their complexity remains in O(n k log n) for k neighbors
+
+// Clarke-Wright savings heuristic: the savings s(i,j) = d(i,0) + d(0,j) - d(i,j) of the arcs (i,j) towards the correlated vertices are processed from a max-heap,
+// and the route ending with i is appended with the route starting with j whenever the merged route respects the capacity and duration limits
+Individual ClarkeWrightSeed(Params & params);
+
+// Nearest neighbor heuristic: each route is extended with the closest unvisited correlated vertex which fits in the vehicle,
+// and a new route starts from the unvisited client closest to the depot when no such vertex exists
+Individual NearestNeighborSeed(Params & params);
+
+// Random giant tour (same as the random individuals of the population)
+Individual RandomKeySeed(Params & params);
 
 #endif
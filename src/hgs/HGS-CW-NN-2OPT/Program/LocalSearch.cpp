@@ -15,6 +15,7 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 			std::shuffle(params.correlatedVertices[i].begin(), params.correlatedVertices[i].end(), params.ran);
 
 	searchCompleted = false;
+	bool isTimeOver = false;
 	for (loopID = 0; !searchCompleted; loopID++)
 	{
 		if (loopID > 1) // Allows at least two loops since some moves involving empty routes are not checked at the first loop
@@ -23,6 +24,13 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 		/* CLASSICAL ROUTE IMPROVEMENT (RI) MOVES SUBJECT TO A PROXIMITY RESTRICTION */
 		for (int posU = 0; posU < params.nbClients; posU++)
 		{
+			// Checking the budget of the current phase every 64 nodes, such that a long local search on a large instance does not overshoot it
+			if (posU % 64 == 0 && params.deadline.isPhaseOver())
+			{
+				isTimeOver = true;
+				break;
+			}
+
 			nodeU = &clients[orderNodes[posU]];
 			int lastTestRINodeU = nodeU->whenLastTestedRI;
 			nodeU->whenLastTestedRI = nbMoves;
@@ -71,6 +79,8 @@ void LocalSearch::run(Individual & indiv, double penaltyCapacityLS, double penal
 			}
 		}
 
+		if (isTimeOver) break;
+
 		if (params.ap.useSwapStar == 1 && params.areCoordinatesProvided)
 		{
 			/* (SWAP*) MOVES LIMITED TO ROUTE PAIRS WHOSE CIRCLE SECTORS OVERLAP */
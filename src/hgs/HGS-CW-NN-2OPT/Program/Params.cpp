@@ -20,7 +20,6 @@ Params::Params(
 	  ap(ap),
 	  penaltyCapacity(0.0),
 	  penaltyDuration(0.0),
-	  startTime(0),
 	  isDurationConstraint(isDurationConstraint),
 	  nbVehicles(nbVeh),
 	  durationLimit(durationLimit),
@@ -28,7 +27,7 @@ Params::Params(
 	  timeCost(dist_mtx)
 {
 	// This marks the starting time of the algorithm
-	startTime = clock();
+	deadline.start(ap.timeLimit, ap.timeLimitPolishing);
 
 	nbClients = (int)demands.size() - 1; // Need to substract the depot from the number of nodes
 	totalDemand = 0.;
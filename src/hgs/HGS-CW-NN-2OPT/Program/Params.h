@@ -25,6 +25,7 @@ SOFTWARE.*/
 
 #include "CircleSector.h"
 #include "AlgorithmParameters.h"
+#include "Deadline.h"
 #include <string>
 #include <vector>
 #include <list>
@@ -62,8 +63,8 @@ public:
 	double penaltyCapacity;				// Penalty for one unit of capacity excess (adapted through the search)
 	double penaltyDuration;				// Penalty for one unit of duration excess (adapted through the search)
 
-	/* START TIME OF THE ALGORITHM */
-	clock_t startTime;                  // Start time of the optimization (set when Params is constructed)
+	/* TIME BUDGETS OF THE ALGORITHM */
+	Deadline deadline;                  // Start time and time budgets of the optimization (started when Params is constructed)
 
 	/* RANDOM NUMBER GENERATOR */       
 	std::minstd_rand ran;               // Using the fastest and simplest LCG. The quality of random numbers is not critical for the LS, but speed is
@@ -1,12 +1,16 @@
 #include "Population.h"
+#include "InitialSeeds.h"
 
 void Population::generatePopulation()
 {
 	if (params.verbose) std::cout << "----- BUILDING INITIAL POPULATION" << std::endl;
-	for (int i = 0; i < 4*params.ap.mu && (i == 0 || params.ap.timeLimit == 0 || (double)(clock() - params.startTime) / (double)CLOCKS_PER_SEC < params.ap.timeLimit) ; i++)
+	for (int i = 0; i < 4*params.ap.mu && (i == 0 || !params.deadline.isPhaseOver()) ; i++)
 	{
+		// The first two individuals are seeded by the Clarke-Wright and nearest neighbor heuristics, the other ones are random
 		Individual randomIndiv(params);
-		split.generalSplit(randomIndiv, params.nbVehicles);
+		if (i == 0) generateClarkeWrightSolution(randomIndiv);
+		else if (i == 1) generateNearestNeighborSolution(randomIndiv);
+		else split.generalSplit(randomIndiv, params.nbVehicles);
 		localSearch.run(randomIndiv, params.penaltyCapacity, params.penaltyDuration);
 		addIndividual(randomIndiv, true);
 		if (!randomIndiv.eval.isFeasible && params.ran() % 2 == 0)  // Repair half of the solutions in case of infeasibility
@@ -17,6 +21,18 @@ void Population::generatePopulation()
 	}
 }
 
+void Population::generateNearestNeighborSolution(Individual & indiv)
+{
+	indiv = NearestNeighborSeed(params);
+	split.generalSplit(indiv, params.nbVehicles);
+}
+
+void Population::generateClarkeWrightSolution(Individual & indiv)
+{
+	indiv = ClarkeWrightSeed(params);
+	split.generalSplit(indiv, params.nbVehicles);
+}
+
 bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
 {
 	if (updateFeasible)
@@ -56,7 +72,7 @@ bool Population::addIndividual(const Individual & indiv, bool updateFeasible)
 		if (indiv.eval.penalizedCost < bestSolutionOverall.eval.penalizedCost - MY_EPSILON)
 		{
 			bestSolutionOverall = indiv;
-			searchProgress.push_back({ clock() - params.startTime , bestSolutionOverall.eval.penalizedCost });
+			searchProgress.push_back({ params.deadline.getElapsedTime() , bestSolutionOverall.eval.penalizedCost });
 		}
 		return true;
 	}
@@ -211,7 +227,7 @@ void Population::printState(int nbIter, int nbIterNoImprovement)
 {
 	if (params.verbose)
 	{
-		std::printf("It %6d %6d | T(s) %.2f", nbIter, nbIterNoImprovement, (double)(clock()-params.startTime)/(double)CLOCKS_PER_SEC);
+		std::printf("It %6d %6d | T(s) %.2f", nbIter, nbIterNoImprovement, params.deadline.getElapsedTime());
 
 		if (getBestFeasible() != NULL) std::printf(" | Feas %zu %.2f %.2f", feasibleSubpop.size(), getBestFeasible()->eval.penalizedCost, getAverageCost(feasibleSubpop));
 		else std::printf(" | NO-FEASIBLE");
@@ -271,8 +287,8 @@ double Population::getAverageCost(const SubPopulation & pop)
 void Population::exportSearchProgress(std::string fileName, std::string instanceName)
 {
 	std::ofstream myfile(fileName);
-	for (std::pair<clock_t, double> state : searchProgress)
-		myfile << instanceName << ";" << params.ap.seed << ";" << state.second << ";" << (double)state.first / (double)CLOCKS_PER_SEC << std::endl;
+	for (std::pair<double, double> state : searchProgress)
+		myfile << instanceName << ";" << params.ap.seed << ";" << state.second << ";" << state.first << std::endl;
 }
 
 void Population::exportCVRPLibFormat(const Individual & indiv, std::string fileName)
@@ -32,7 +32,10 @@ typedef std::vector <Individual*> SubPopulation ;
 class Population
 {
    private:
+   // Builds a seed of the initial population with the nearest neighbor heuristic (see InitialSeeds.h), followed by Split
    void generateNearestNeighborSolution(Individual& indiv);
+
+   // Builds a seed of the initial population with the Clarke-Wright savings heuristic (see InitialSeeds.h), followed by Split
    void generateClarkeWrightSolution(Individual& indiv);
 
    Params & params ;							// Problem parameters
@@ -42,7 +45,7 @@ class Population
    SubPopulation infeasibleSubpop;		        // Infeasible subpopulation, kept ordered by increasing penalized cost
    std::list <bool> listFeasibilityLoad ;		// Load feasibility of recent individuals generated by LS
    std::list <bool> listFeasibilityDuration ;	// Duration feasibility of recent individuals generated by LS
-   std::vector<std::pair<clock_t, double>> searchProgress; // Keeps tracks of the time stamps of successive best solutions
+   std::vector<std::pair<double, double>> searchProgress; // Keeps tracks of the time stamps (in seconds) of successive best solutions
    Individual bestSolutionRestart;              // Best solution found during the current restart of the algorithm
    Individual bestSolutionOverall;              // Best solution found during the complete execution of the algorithm
 